@@ -0,0 +1,93 @@
+/**
+ * @file arena.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of bump allocator of the structures used while the circuit is built.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+Class representing arena, allocator handing out consecutive pieces of large blocks.
+Objects are never freed one by one, all of them are released at once by releasing the blocks, so they have to be trivially destructible.
+Allocation costs a pointer increment, and there is no per object header or reference counter.
+ */
+class Arena
+{
+	static const size_t block_size = 1 << 16;			//**<Size of the ordinary block in bytes, bigger requests get a block of their own
+	std::vector< std::unique_ptr< char[] > > blocks;	//**<Allocated blocks
+	char * next;										//**<First free byte of the last block
+	char * end;											//**<End of the last block
+
+	/** Method reserves bytes aligned for any fundamental type.
+		@param size Number of bytes.
+		@return Method returns pointer to the reserved bytes.
+	*/
+	void * allocate( size_t size ){
+		const size_t alignment = alignof( std::max_align_t );
+		size = ( size + alignment - 1 ) & ~( alignment - 1 );
+		if( size_t( this->end - this->next ) < size ){
+			size_t allocated = size > block_size ? size : block_size;
+			this->blocks.emplace_back( new char[ allocated ] );
+			this->next = this->blocks.back().get();
+			this->end = this->next + allocated;
+		}
+		void * piece = this->next;
+		this->next += size;
+		return piece;
+	}
+
+public:
+	/**
+		Constructor creating empty arena.
+	*/
+	Arena() : next( NULL ), end( NULL ){
+	}
+
+	Arena( const Arena & ) = delete;
+	Arena & operator=( const Arena & ) = delete;
+
+	/** Method creates object in the arena.
+		@param arguments Arguments of the constructor of the object.
+		@return Method returns pointer to the object, valid until the arena is cleared.
+	*/
+	template< typename T, typename... Arguments >
+	T * create( Arguments &&... arguments ){
+		static_assert( std::is_trivially_destructible< T >::value, "objects of the arena are never destroyed" );
+		return new( this->allocate( sizeof( T ) ) ) T( std::forward< Arguments >( arguments )... );
+	}
+
+	/** Method creates array of value initialized objects in the arena.
+		@param count Number of objects.
+		@return Method returns pointer to the first object, valid until the arena is cleared, NULL if count is 0.
+	*/
+	template< typename T >
+	T * create_array( size_t count ){
+		static_assert( std::is_trivially_destructible< T >::value, "objects of the arena are never destroyed" );
+		if( count == 0 ){
+			return NULL;
+		}
+		T * array = static_cast< T * >( this->allocate( sizeof( T ) * count ) );
+		for( size_t i = 0; i < count; i++ ){
+			new( array + i ) T();
+		}
+		return array;
+	}
+
+	/** Method releases all objects of the arena at once. */
+	void clear(){
+		this->blocks.clear();
+		this->next = NULL;
+		this->end = NULL;
+	}
+};
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * @file benchmark.cpp
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief Harness measuring time of the separate simulation phases.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "circuit.h"
+#include "parse_options.h"
+
+/**
+	Class measuring time elapsed since its creation or last restart.
+*/
+class Stopwatch
+{
+	std::chrono::steady_clock::time_point start;	//**<Moment of the last restart
+
+public:
+	Stopwatch(){
+		this->restart();
+	}
+
+	/** Method starts measuring from now. */
+	void restart(){
+		this->start = std::chrono::steady_clock::now();
+	}
+
+	/**
+		@return Method returns number of seconds elapsed since the last restart.
+	*/
+	double seconds() const{
+		return std::chrono::duration< double >( std::chrono::steady_clock::now() - this->start ).count();
+	}
+};
+
+/** Function prints duration of a phase.
+	@param phase Name of the phase.
+	@param seconds Duration of the phase.
+*/
+void report( const std::string & phase, double seconds ){
+	std::cout<<std::left<<std::setw( 16 )<<phase<<std::right<<std::fixed<<std::setprecision( 3 )<<std::setw( 12 )<<seconds * 1000<<" ms\n";
+}
+
+/** Function prints errors of the circuit.
+	@param circuit Simulated circuit.
+	@return Function returns status of the circuit.
+*/
+bool check( Circuit & circuit ){
+	for( const auto & error : circuit.get_errors() ){
+		std::cout<<error<<std::endl;
+	}
+	circuit.clear_errors();
+	return circuit.good();
+}
+
+int main( int argc, char **argv ){
+	//Evaluation is repeated until it takes at least this long, so short runs are measured reliably
+	const double minimal_evaluation = 0.5;
+
+	Options options;
+
+	std::string parse_error = parse_options( argc, argv, options );
+	if( parse_error != "" ){
+		std::cout<<parse_error;
+		return 0;
+	}
+
+	Circuit circuit;
+	circuit.set_width( options.width );
+	circuit.set_threads( options.threads );
+	circuit.set_testbenches( options.testbenches );
+	circuit.set_binary_output( options.binary_output );
+	circuit.set_event_driven( options.event_driven );
+	circuit.set_four_valued( options.four_valued );
+
+	std::cout<<options.circuit_file<<"\n";
+	Stopwatch stopwatch;
+	circuit.build( options.circuit_file );
+	report( "build", stopwatch.seconds() );
+	if( !check( circuit ) ){
+		return 1;
+	}
+	if( options.optimize ){
+		stopwatch.restart();
+		circuit.optimize();
+		report( "optimize", stopwatch.seconds() );
+	}
+	if( options.native ){
+		stopwatch.restart();
+		circuit.compile_native();
+		report( "compile_native", stopwatch.seconds() );
+		check( circuit );
+	}
+	if( options.batch_size ){
+		stopwatch.restart();
+		circuit.simulate( options.input_file, options.output_file, options.batch_size );
+		report( "simulate", stopwatch.seconds() );
+		return check( circuit ) ? 0 : 1;
+	}
+
+	stopwatch.restart();
+	circuit.readInputs( options.input_file );
+	report( "readInputs", stopwatch.seconds() );
+	if( !check( circuit ) ){
+		return 1;
+	}
+
+	int repeats = 0;
+	stopwatch.restart();
+	do{
+		//Sequential circuit starts every repetition from the first clock cycle again
+		circuit.reset_registers();
+		circuit.evaluate();
+		repeats++;
+	}while( stopwatch.seconds() < minimal_evaluation && circuit.good() );
+	double evaluation = stopwatch.seconds() / repeats;
+	report( "evaluate", evaluation );
+	if( !check( circuit ) ){
+		return 1;
+	}
+
+	stopwatch.restart();
+	circuit.writeOutputs( options.output_file );
+	report( "writeOutputs", stopwatch.seconds() );
+	if( !check( circuit ) ){
+		return 1;
+	}
+
+	double throughput = double( circuit.gate_count() ) * circuit.vector_count() / evaluation;
+	std::cout<<"gates: "<<circuit.gate_count()<<" vectors: "<<circuit.vector_count()<<" evaluations: "<<repeats<<"\n";
+	std::cout<<"throughput: "<<std::scientific<<std::setprecision( 3 )<<throughput<<" gates*vectors/s\n\n";
+	return 0;
+}
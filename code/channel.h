@@ -0,0 +1,71 @@
+/**
+ * @file channel.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of bounded queue connecting stages of the simulation pipeline.
+ */
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+Class representing bounded, blocking queue passing items between threads.
+Producer blocks when the queue is full, consumer blocks when it is empty until an item arrives or the channel is closed.
+ */
+template< typename T >
+class Channel
+{
+	std::deque< T > items;				//**<Items waiting in the queue
+	size_t capacity;					//**<Maximal number of items waiting in the queue
+	bool closed;						//**<Flag set when no more items will be pushed
+	std::mutex mutex;					//**<Mutex guarding the queue
+	std::condition_variable changed;	//**<Condition signalled when an item is pushed, popped or the channel is closed
+
+public:
+	/**
+		Constructor creating empty channel.
+		@param capacity Maximal number of items waiting in the queue.
+	*/
+	Channel( size_t capacity ) : capacity( capacity ), closed( false ){
+	}
+
+	/** Method puts an item at the end of the queue, waiting while the queue is full.
+		@param item Item to be put.
+	*/
+	void push( T item ){
+		std::unique_lock< std::mutex > lock( this->mutex );
+		this->changed.wait( lock, [ this ](){ return this->items.size() < this->capacity; } );
+		this->items.push_back( std::move( item ) );
+		this->changed.notify_all();
+	}
+
+	/** Method takes an item from the front of the queue, waiting while the queue is empty.
+		@param [out] item Taken item.
+		@return Method returns false if the queue is empty and the channel has been closed.
+	*/
+	bool pop( T & item ){
+		std::unique_lock< std::mutex > lock( this->mutex );
+		this->changed.wait( lock, [ this ](){ return !this->items.empty() || this->closed; } );
+		if( this->items.empty() ){
+			return false;
+		}
+		item = std::move( this->items.front() );
+		this->items.pop_front();
+		this->changed.notify_all();
+		return true;
+	}
+
+	/** Method marks the channel as closed, consumers get remaining items and then stop waiting.
+	*/
+	void close(){
+		std::lock_guard< std::mutex > lock( this->mutex );
+		this->closed = true;
+		this->changed.notify_all();
+	}
+};
+
+#endif
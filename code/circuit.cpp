@@ -1,93 +1,260 @@
+#include <climits>
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
 #include <map>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 
 #include "circuit.h"
+#include "four_valued.h"
 #include "gate.h"
+#include "lanes.h"
+#include "mapped_file.h"
+#include "netlist_file.h"
+#include "optimizer.h"
+#include "timing_wheel.h"
+#include "tokenizer.h"
+#include "vector_file.h"
 
 
+//Number of sets generated at once by exhaustive enumeration
+static const uint64_t enumeration_batch = 1 << 16;
+
 /**
 	Generic constructor with no parameters, sets up flags.
 */
 Circuit::Circuit(){
 	this->_good = true;
 	this->built = false;
+	this->width = 64;
+	this->pool.reset( new ThreadPool( 1 ) );
+	this->binary_output = false;
+	this->event_driven = false;
+	this->testbenches = 1;
+	this->four_valued = false;
+	this->activity = false;
+	this->activity_sets = 0;
+	this->traced_sets = 0;
+}
+
+/** Method selects event driven evaluation, which evaluates only gates affected by inputs changed since the previous set.
+	@param event_driven True if sets are evaluated event driven, false if they are evaluated bit-parallel.
+*/
+void Circuit::set_event_driven( bool event_driven ){
+	this->event_driven = event_driven;
+}
+
+/** Method selects format of the output file.
+	@param binary True if outputs are written in the packed binary format, false if they are written as text.
+*/
+void Circuit::set_binary_output( bool binary ){
+	this->binary_output = binary;
+}
+
+/** Method sets number of threads evaluating sets of input data.
+	@param threads Number of threads, at least 1.
+	@return Method returns true if the number is correct, otherwise returns false and sets an error message.
+*/
+bool Circuit::set_threads( int threads ){
+	if( threads < 1 ){
+		this->errors.push_back( "error: incorrect number of threads: " + std::to_string( threads ) );
+		this->_good = false;
+		return false;
+	}
+	this->pool.reset( new ThreadPool( threads ) );
+	this->clusters.clear();
+	return true;
+}
+
+/** Method sets number of input vectors simulated in parallel by every sweep over the circuit.
+	@param width Number of vectors, 64, 256 or 512.
+	@return Method returns true if the number is supported, otherwise returns false and sets an error message.
+*/
+bool Circuit::set_width( int width ){
+	if( width != 64 && width != 256 && width != 512 ){
+		this->errors.push_back( "error: unsupported number of parallel vectors: " + std::to_string( width ) );
+		this->_good = false;
+		return false;
+	}
+	this->width = width;
+	return true;
+}
+
+/** Method sets number of independent testbenches simulated in parallel by sequential circuits.
+	@param testbenches Number of testbenches, at least 1.
+	@return Method returns true if the number is correct, otherwise returns false and sets an error message.
+*/
+bool Circuit::set_testbenches( int testbenches ){
+	if( testbenches < 1 ){
+		this->errors.push_back( "error: incorrect number of testbenches: " + std::to_string( testbenches ) );
+		this->_good = false;
+		return false;
+	}
+	this->testbenches = testbenches;
+	this->register_state.clear();
+	return true;
+}
+
+/** Method selects counting of activity of every node by bit-parallel evaluation of combinational circuits:
+	number of sets where it is 1 and number of its changes between consecutive sets, counted with population count of the packed values.
+	@param activity True if the activity is counted.
+*/
+void Circuit::set_activity( bool activity ){
+	this->activity = activity;
+}
+
+/** Method selects four-valued simulation, which propagates unknown X and high impedance Z through the gates.
+	Inputs missing in a set or given as X are unknown, flip-flops and latches start unknown. It is evaluated bit-parallel on two bit-planes, without native code.
+	@param four_valued True if values 0, 1, X and Z are simulated, false if only 0 and 1 are.
+*/
+void Circuit::set_four_valued( bool four_valued ){
+	this->four_valued = four_valued;
+	this->reset_registers();
+}
+
+/** Method sets all flip-flops and latches to their initial value, so the next set starts the first clock cycle again. */
+void Circuit::reset_registers(){
+	this->register_state.clear();
+	this->state.clear();
 }
 
 /** Method builds a circuit structure according to the circuit file.
+ Files starting with the magic of the snapshot format are loaded instead of being parsed.
+ Gates list their input nodes followed by the output node: AND, NAND, OR, NOR, XOR and XNOR take two or more inputs,
+ "MUX <select> <input0> <input1> <output>" passes input1 when select is 1, "LUT <table> <inputs> <output>" takes 2 to 6 inputs
+ and truth table given in decimal or hexadecimal with 0x prefix, bit i of the table is the output when every input j has value of bit j of i.
+ "DFF <input> <output>" is flip-flop clocked between sets, "LATCH <enable> <input> <output>" passes its input while enable is 1,
+ both start at 0, or at X in four-valued simulation, and loops through flip-flops are allowed.
+ Lines between "MODULE <name>" and "END" define a module with its own IN: and OUT: ports and local node numbers,
+ "INST <name> <input nodes> <output nodes>" places copy of a module defined before, its internal nodes are numbered above all nodes of the file.
  @return Method returns true if circuit has been built succesfully, otherwise returns false and sets an error message.
   @param fname Name of the file where the circuit structure is stored.
 */ 
 int Circuit::build( const std::string & fname ){
-	std::ifstream file( fname );
-	if( !file ){
+	if( NetlistFile::is_snapshot( fname ) ){
+		return this->load( fname ) ? 0 : 1;
+	}
+	MappedFile file;
+	if( !file.open( fname ) ){
 		this->errors.push_back( "error: Couldn't open circuit file for reading!" );
 		this->_good = false;
 		return 1;
 	}
 
-	//Initializing map connecting names of the gates to functions evaluating them
-	std::unordered_map< std::string, evaluating_function > evaluating_functions; 
-	evaluating_functions[ "IN:" ] = evaluate_in;
-	evaluating_functions[ "OUT:" ] = evaluate_out;
-	evaluating_functions[ "NEG" ] = evaluate_neg;
-	evaluating_functions[ "NOT" ] = evaluate_neg;
-	evaluating_functions[ "AND" ] = evaluate_and;
-	evaluating_functions[ "NAND" ] = evaluate_nand;
-	evaluating_functions[ "OR" ] = evaluate_or;
-	evaluating_functions[ "NOR" ] = evaluate_nor;
-	evaluating_functions[ "XOR" ] = evaluate_xor;
-	evaluating_functions[ "XNOR" ] = evaluate_xnor;
-
-
-	//Reading circuit structure from file
-	std::string line;
-	int line_no = 0;
-	while( getline( file, line ) ){
-		line_no++;
-		if(line == "\r" || line == "")
+	//Reading circuit structure from file, tokens are parsed in place
+	this->counters.bytes_parsed += file.size();
+	Tokenizer tokenizer( file.data(), file.data() + file.size() );
+	size_t module = SIZE_MAX;
+	std::vector< int > nodes;
+	while( tokenizer.next_line() ){
+		std::string_view op;
+		if( !tokenizer.token( op ) )
 			continue;
-		std::stringstream stream( line );
-		std::string op;
-		int node1 = 0;
-		int node2 = 0;
-		int node3 = 0;
-		stream>>op;
+		if( op == "MODULE" || op == "END" || op == "INST" ){
+			this->read_module_line( op, tokenizer, fname, module );
+			continue;
+		}
+		Operation operation;
+		if( !find_operation( op, operation ) ){
+			this->errors.push_back( fname + ": line: " + std::to_string( tokenizer.line() ) + " warning: ommiting line - unknown gate: " + std::string( op ) );
+			this->_good = false;
+			continue;
+		}
 		
-		if( op == "IN:" ){
-			int node = 0;
-			while( stream>>node ){
-				std::shared_ptr<Gate> gate = Gate::create( evaluating_functions, op, node );
-				this->gates[gate->output] = gate;
-				this->inputs[gate->output] = gate;
-			}
-		}else if( op == "OUT:" ){
+		if( operation == OPERATION_IN || operation == OPERATION_OUT ){
+			std::string_view token;
 			int node = 0;
-			while( stream>>node ){
-				std::shared_ptr<Gate> gate = Gate::create( evaluating_functions, op, node );
-				this->outputs.push_back( gate );
+			while( tokenizer.token( token ) ){
+				Gate * gate = NULL;
+				if( Tokenizer::number( token, node ) ){
+					gate = Gate::create( this->arena, operation, node );
+				}
+				if( gate == NULL ){
+					this->errors.push_back( fname + ": line: " + std::to_string( tokenizer.line() ) + " warning: ommiting incorrect node: " + std::string( token ) );
+					this->_good = false;
+					continue;
+				}
+				if( module != SIZE_MAX ){
+					//Inside of a module the lines declare its ports
+					auto & ports = operation == OPERATION_IN ? this->modules[ module ].inputs : this->modules[ module ].outputs;
+					ports.push_back( node );
+				}else if( operation == OPERATION_IN ){
+					this->gates[gate->output] = gate;
+					this->inputs[gate->output] = gate;
+				}else{
+					this->outputs.push_back( gate );
+				}
 			}
 		}else{
-
-			stream>>node1>>node2>>node3;
-			std::shared_ptr<Gate> gate = Gate::create( evaluating_functions, op, node1, node2, node3 );
-			if(gate!=NULL){
+			//Gate lists its input nodes followed by the output node, lookup table starts with its truth table
+			std::string_view token;
+			uint64_t table = 0;
+			bool correct = operation != OPERATION_LUT || ( tokenizer.token( token ) && Tokenizer::number( token, table ) );
+			nodes.clear();
+			while( tokenizer.token( token ) ){
+				int node = 0;
+				correct = correct && Tokenizer::number( token, node );
+				nodes.push_back( node );
+			}
+			Gate * gate = NULL;
+			if( correct ){
+				gate = Gate::create( this->arena, operation, nodes, table );
+			}
+			if( gate != NULL && module != SIZE_MAX ){
+				this->modules[ module ].gates.push_back( *gate );
+			}else if(gate!=NULL){
 				this->gates[gate->output] = gate;			
 			}
 			else{
-				this->errors.push_back( fname + ": line: " + std::to_string(line_no) + " warning: ommiting line - incorrect data" );
+				this->errors.push_back( fname + ": line: " + std::to_string( tokenizer.line() ) + " warning: ommiting line - incorrect data" );
 				this->_good = false;
 			}
 		}
 		
 	}
 	file.close();
+	if( module != SIZE_MAX ){
+		this->errors.push_back( fname + ": error: module without END: " + this->modules[ module ].name );
+		this->_good = false;
+	}
+
+	//Instances get node numbers above all nodes of the file
+	if( !this->instances.empty() ){
+		int64_t last = this->gates.empty() ? 0 : this->gates.rbegin()->first;
+		uint64_t created = 0;
+		for( const auto & output : this->outputs ){
+			last = std::max< int64_t >( last, output->input1 );
+		}
+		for( const auto & instance : this->instances ){
+			for( int port : instance.ports ){
+				last = std::max< int64_t >( last, port );
+			}
+			created += this->modules[ instance.module ].node_count;
+		}
+		if( last + created > INT_MAX ){
+			this->errors.push_back( fname + ": error: instances of modules create too many nodes" );
+			this->_good = false;
+		}else{
+			int next = last + 1;
+			for( const auto & instance : this->instances ){
+				this->instantiate( this->modules[ instance.module ], instance.ports, next );
+			}
+		}
+	}
+	this->instances.clear();
+	this->modules.clear();
+	this->module_indices.clear();
 
 	//actually building dependencies tree
 	for( const auto & i : this->gates ){
-		auto gate = i.second;
+		Gate * gate = i.second;
 		if( gate->input1 != 0 ){
 			if( this->gates.find( gate->input1 ) == this->gates.end() ){
 				this->errors.push_back( fname + ": error: unplugged input node: " + std::to_string(gate->input1) );
@@ -104,6 +271,16 @@ int Circuit::build( const std::string & fname ){
 				gate->input2_ptr = this->gates[ gate->input2 ];
 			}
 		}
+		gate->extra_inputs_ptr = this->arena.create_array< Gate * >( gate->extra_count );
+		for( uint32_t i = 0; i < gate->extra_count; i++ ){
+			auto found = this->gates.find( gate->extra_inputs[i] );
+			if( found == this->gates.end() ){
+				this->errors.push_back( fname + ": error: unplugged input node: " + std::to_string( gate->extra_inputs[i] ) );
+				this->_good = false;
+			}else{
+				gate->extra_inputs_ptr[i] = found->second;
+			}
+		}
 
 	}
 
@@ -115,140 +292,2189 @@ int Circuit::build( const std::string & fname ){
 			gate->input1_ptr = this->gates[ gate->input1 ];
 		}
 	}
+	if( !this->_good || !this->compile( fname ) ){
+		return 1;
+	}
 	this->built = true;
 	return 0;
 }
 
-/** Method reads sets of inputs from the file and puts them into object's internal vector.
-	@param fname Name of the file where the inputs are stored.
-	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+/** Method reads line of the circuit file defining or instantiating a module.
+	@param keyword First token of the line: MODULE, END or INST.
+	@param tokenizer Tokenizer of the circuit file, positioned after the keyword.
+	@param fname Name of the file where the circuit structure is stored, used in error messages.
+	@param [in,out] module Index of the module being defined, SIZE_MAX outside of modules.
 */
-bool Circuit::readInputs( const std::string & fname ){
-	if( !this->built ){
-		this->errors.push_back( "error: Circuit not built" );
+void Circuit::read_module_line( std::string_view keyword, Tokenizer & tokenizer, const std::string & fname, size_t & module ){
+	std::string line = fname + ": line: " + std::to_string( tokenizer.line() );
+	std::string_view name;
+	if( keyword == "MODULE" ){
+		if( module != SIZE_MAX || !tokenizer.token( name ) ){
+			this->errors.push_back( line + " warning: ommiting line - incorrect data" );
+			this->_good = false;
+			return;
+		}
+		module = this->modules.size();
+		this->modules.push_back( Module() );
+		this->modules[ module ].name = name;
+		return;
+	}
+	if( keyword == "END" ){
+		if( module == SIZE_MAX ){
+			this->errors.push_back( line + " warning: ommiting line - END outside of module" );
+			this->_good = false;
+			return;
+		}
+		Module & finished = this->modules[ module ];
+		if( this->module_indices.count( finished.name ) ){
+			this->errors.push_back( line + " error: redefinition of module: " + finished.name );
+			this->_good = false;
+		}else if( this->finish_module( finished, fname, tokenizer.line() ) ){
+			this->module_indices[ finished.name ] = module;
+		}
+		module = SIZE_MAX;
+		return;
+	}
+
+	//Instance lists nodes connected to the inputs of the module followed by nodes connected to its outputs
+	auto found = tokenizer.token( name ) ? this->module_indices.find( name ) : this->module_indices.end();
+	if( found == this->module_indices.end() ){
+		this->errors.push_back( line + " warning: ommiting line - unknown module: " + std::string( name ) );
 		this->_good = false;
-		return false;
+		return;
 	}
-	std::ifstream file( fname );
-	if( !file ){
-		this->errors.push_back( "error: Couldn't open inputs file for reading!");
+	Instance instance;
+	instance.module = found->second;
+	std::string_view token;
+	int node = 0;
+	while( tokenizer.token( token ) ){
+		if( !Tokenizer::number( token, node ) || node <= 0 ){
+			this->errors.push_back( line + " warning: ommiting line - incorrect data" );
+			this->_good = false;
+			return;
+		}
+		instance.ports.push_back( node );
+	}
+	const Module & instantiated = this->modules[ instance.module ];
+	if( instance.ports.size() != instantiated.inputs.size() + instantiated.outputs.size() ){
+		this->errors.push_back( line + " warning: ommiting line - module " + instantiated.name + " has " + std::to_string( instantiated.inputs.size() ) + " inputs and " + std::to_string( instantiated.outputs.size() ) + " outputs" );
 		this->_good = false;
-		return false;
+		return;
 	}
+	if( module != SIZE_MAX ){
+		this->modules[ module ].instances.push_back( instance );
+	}else{
+		this->instances.push_back( instance );
+	}
+}
 
-	//Reading inputs from the file
-	std::string line;
-	int line_no = 0;
-	while( getline( file, line ) ){
-		line_no++;
-		if(line == "\r" || line == "")
-			continue;
-		std::map< int, bool > set;
-		std::stringstream stream( line );
-		std::string input;
-		while( stream>>input ){
-			auto separator_position = input.find_first_of( ':' ) + 1;
-			int node = stoi( input.substr( 0, separator_position ) );
-			//Checking if node is an input node
-			if( this->inputs.find( node ) == this->inputs.end() ){
-				this->errors.push_back( fname + ": line: " + std::to_string( line_no ) + " warning: incorrect input node: " + std::to_string( node )  ); 
-				continue;
-			}
+/** Method checks that every node of the finished module is driven and counts the nodes created by its instances.
+	@param module Defined module.
+	@param fname Name of the file where the circuit structure is stored, used in error messages.
+	@param line Number of the line ending the module.
+	@return Method returns false if the module is incorrect.
+*/
+bool Circuit::finish_module( Module & module, const std::string & fname, int line ){
+	std::map< int, bool > driven;
+	for( int node : module.inputs ){
+		driven[ node ] = true;
+	}
+	std::vector< int > used( module.outputs );
+	for( const Gate & gate : module.gates ){
+		driven[ gate.output ] = true;
+		used.push_back( gate.input1 );
+		if( operation_inputs( gate.operation ) >= 2 ){
+			used.push_back( gate.input2 );
+		}
+		used.insert( used.end(), gate.extra_inputs, gate.extra_inputs + gate.extra_count );
+	}
+	module.node_count = 0;
+	for( const Instance & instance : module.instances ){
+		const Module & instantiated = this->modules[ instance.module ];
+		size_t input_count = instantiated.inputs.size();
+		used.insert( used.end(), instance.ports.begin(), instance.ports.begin() + input_count );
+		for( size_t i = input_count; i < instance.ports.size(); i++ ){
+			driven[ instance.ports[i] ] = true;
+		}
+		//Count of nested instances grows exponentially with depth, it is saturated so the build reports too many nodes instead of wrapping around
+		module.node_count = std::min< uint64_t >( module.node_count + instantiated.node_count, INT_MAX );
+	}
+	bool correct = true;
+	for( int node : used ){
+		if( !driven.count( node ) ){
+			this->errors.push_back( fname + ": line: " + std::to_string( line ) + " error: unplugged node in module " + module.name + ": " + std::to_string( node ) );
+			this->_good = false;
+			correct = false;
+			driven[ node ] = true;
+		}
+	}
+	for( const auto & node : driven ){
+		if( std::find( module.inputs.begin(), module.inputs.end(), node.first ) == module.inputs.end() &&
+			std::find( module.outputs.begin(), module.outputs.end(), node.first ) == module.outputs.end() ){
+			module.node_count++;
+		}
+	}
+	return correct;
+}
 
-			bool value = stoi( input.substr( separator_position ) );
-			set[ node ] = value;
+/** Method creates gates of the module instance, internal nodes of the module get fresh numbers.
+	@param module Instantiated module.
+	@param ports Nodes connected to the inputs and then to the outputs of the module.
+	@param [in,out] next Next free number of node.
+*/
+void Circuit::instantiate( const Module & module, const std::vector< int > & ports, int & next ){
+	std::unordered_map< int, int > nodes;
+	for( size_t i = 0; i < module.inputs.size(); i++ ){
+		nodes[ module.inputs[i] ] = ports[i];
+	}
+	for( size_t i = 0; i < module.outputs.size(); i++ ){
+		nodes[ module.outputs[i] ] = ports[ module.inputs.size() + i ];
+	}
+	auto global = [ & ]( int node ){
+		auto found = nodes.find( node );
+		if( found != nodes.end() ){
+			return found->second;
 		}
+		return nodes[ node ] = next++;
+	};
+	std::vector< int > gate_nodes;
+	for( const Gate & gate : module.gates ){
+		gate_nodes.assign( 1, global( gate.input1 ) );
+		if( operation_inputs( gate.operation ) >= 2 ){
+			gate_nodes.push_back( global( gate.input2 ) );
+		}
+		for( uint32_t i = 0; i < gate.extra_count; i++ ){
+			gate_nodes.push_back( global( gate.extra_inputs[i] ) );
+		}
+		gate_nodes.push_back( global( gate.output ) );
+		Gate * copy = Gate::create( this->arena, gate.operation, gate_nodes, gate.table );
+		this->gates[ copy->output ] = copy;
+	}
+	for( const Instance & instance : module.instances ){
+		std::vector< int > instance_ports;
+		for( int port : instance.ports ){
+			instance_ports.push_back( global( port ) );
+		}
+		this->instantiate( this->modules[ instance.module ], instance_ports, next );
+	}
+}
 
-		//Looking for input nodes not present in set of inputs
-		std::vector< int > missing_inputs;
-		for( const auto & input : this->inputs ){
-			if( set.find( input.first ) == set.end() ){
-				missing_inputs.push_back(input.first);
+/** Method levelizes built circuit into netlist with nodes renumbered in topological order.
+	Only gates driving the output nodes are compiled.
+	@param fname Name of the file where the circuit structure is stored, used in error messages.
+	@return Method returns true if the circuit has been compiled succesfully, otherwise returns false and sets an error message.
+*/
+bool Circuit::compile( const std::string & fname ){
+	//Depth first search computing level of every gate in cones of the outputs, level is kept in the gate itself
+	//Flip-flops end the search at level 0 and their inputs become further roots, so loops through them are allowed
+	std::vector< const Gate * > order;
+	std::vector< Gate * > stack;
+	std::vector< Gate * > inputs;
+	std::vector< Gate * > roots;
+	std::vector< const Gate * > flip_flops;
+	for( const auto & output : this->outputs ){
+		roots.push_back( output->input1_ptr );
+	}
+	for( size_t root = 0; root < roots.size(); root++ ){
+		stack.push_back( roots[ root ] );
+		while( !stack.empty() ){
+			Gate * gate = stack.back();
+			if( gate->operation == OPERATION_DFF ){
+				if( gate->level == -2 ){
+					gate->level = 0;
+					order.push_back( gate );
+					flip_flops.push_back( gate );
+					roots.push_back( gate->input1_ptr );
+				}
+				stack.pop_back();
+				continue;
+			}
+			inputs.assign( { gate->input1_ptr, gate->input2_ptr } );
+			inputs.insert( inputs.end(), gate->extra_inputs_ptr, gate->extra_inputs_ptr + gate->extra_count );
+			if( gate->level == -2 ){
+				gate->level = -1;
+				for( Gate * input : inputs ){
+					if( input == NULL ){
+						continue;
+					}
+					if( input->level == -2 ){
+						stack.push_back( input );
+					}else if( input->level == -1 ){
+						this->errors.push_back( fname + ": error: combinational loop through node: " + std::to_string( input->output ) );
+						this->_good = false;
+						return false;
+					}
+				}
+			}else if( gate->level == -1 ){
+				int level = 0;
+				for( const Gate * input : inputs ){
+					if( input != NULL ){
+						level = std::max( level, input->level + 1 );
+					}
+				}
+				gate->level = level;
+				order.push_back( gate );
+				stack.pop_back();
+			}else{
+				stack.pop_back();
 			}
 		}
+	}
 
-		if( missing_inputs.size() ){
-			std::string warning = fname + ": line: " + std::to_string(line_no) + "warning: following outputs have no defined value and will be defaulted to 0: ";
-			for( int i : missing_inputs ){
-				warning += std::to_string( i ) + " ";
+	//Sorting gates by level, input nodes come first at level 0 so they occupy first indices, flip-flops follow them
+	std::stable_sort( order.begin(), order.end(), []( const Gate * a, const Gate * b ){
+		return std::make_pair( a->level, a->operation != OPERATION_IN ) < std::make_pair( b->level, b->operation != OPERATION_IN );
+	} );
+
+	//Renumbering nodes to dense indices in the sorted order
+	std::unordered_map< int, uint32_t > indices;
+	std::vector< uint32_t > fanin;
+	this->netlist.clear();
+	this->output_indices.clear();
+	for( const Gate * gate : order ){
+		fanin.clear();
+		if( gate->operation == OPERATION_IN ){
+			this->netlist.input_count++;
+		}else if( gate->operation == OPERATION_DFF ){
+			//Input of flip-flop may not have an index yet, it is connected below
+			fanin.push_back( 0 );
+		}else{
+			fanin.push_back( indices[ gate->input1 ] );
+			if( gate->input2_ptr ){
+				fanin.push_back( indices[ gate->input2 ] );
+			}
+			for( uint32_t i = 0; i < gate->extra_count; i++ ){
+				fanin.push_back( indices[ gate->extra_inputs[i] ] );
 			}
-			this->errors.push_back( warning );
 		}
-		this->input_sets.push_back( set );
+		indices[ gate->output ] = this->netlist.add( gate->operation, fanin, gate->table, gate->output, gate->level );
 	}
+	for( const Gate * gate : flip_flops ){
+		this->netlist.inputs1[ indices[ gate->output ] ] = indices[ gate->input1 ];
+	}
+	this->netlist.build_fanouts();
+	this->find_registers();
+	this->clusters.clear();
 
-	file.close();
+	this->input_indices.clear();
+	this->input_columns.clear();
+	for( const auto & input : this->inputs ){
+		int column = this->input_columns.size();
+		this->input_columns[ input.first ] = column;
+		auto index = indices.find( input.first );
+		this->input_indices.push_back( index != indices.end() && index->second < this->netlist.input_count ? index->second : -1 );
+	}
+	std::map< int, int > output_columns;
+	for( const auto & output : this->outputs ){
+		output_columns[ output->input1 ] = indices[ output->input1 ];
+	}
+	this->output_nodes.clear();
+	for( const auto & output : output_columns ){
+		this->output_nodes.push_back( output.first );
+		this->output_indices.push_back( output.second );
+	}
+	this->input_sets.reset( this->input_columns.size() );
+	this->output_sets.reset( this->output_nodes.size() );
+
+	//Gates not reached from the outputs are not compiled, their numbers are kept for fault grading
+	this->unconnected.clear();
+	for( const auto & i : this->gates ){
+		if( i.second->level == -2 && i.second->operation != OPERATION_IN ){
+			this->unconnected.push_back( i.first );
+		}
+	}
+
+	//Structure of gates is not needed for evaluation anymore, releasing it leaves only the netlist in memory
+	this->gates.clear();
+	this->inputs.clear();
+	this->outputs.clear();
+	this->arena.clear();
 	return true;
 }
-/** Method evaluates output values for each set of input data and stores them in object's internal vector.
-@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+
+/** Method loads circuit compiled before from the binary snapshot, without parsing and levelizing it.
+	@param fname Name of the snapshot file.
+	@return Method returns true if the circuit has been loaded succesfully, otherwise returns false and sets an error message.
 */
-bool Circuit::evaluate(){
+bool Circuit::load( const std::string & fname ){
+	CompiledCircuit compiled;
+	std::string error = NetlistFile::read( fname, compiled );
+	if( error != "" ){
+		this->errors.push_back( error );
+		this->_good = false;
+		return false;
+	}
+	this->netlist = std::move( compiled.netlist );
+	this->input_columns.clear();
+	for( int node : compiled.input_nodes ){
+		int column = this->input_columns.size();
+		this->input_columns[ node ] = column;
+	}
+	this->input_indices = std::move( compiled.input_indices );
+	this->output_nodes = std::move( compiled.output_nodes );
+	this->output_indices = std::move( compiled.output_indices );
+	this->unconnected = std::move( compiled.unconnected_nodes );
+	this->input_sets.reset( this->input_columns.size() );
+	this->output_sets.reset( this->output_nodes.size() );
+	this->find_registers();
+	this->clusters.clear();
+	this->built = true;
+	return true;
+}
+
+/** Method collects flip-flops and latches of the netlist and clears their values. */
+void Circuit::find_registers(){
+	this->registers.clear();
+	for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+		if( this->netlist.operations[ node ] == OPERATION_DFF || this->netlist.operations[ node ] == OPERATION_LATCH ){
+			this->registers.push_back( node );
+		}
+	}
+	this->reset_registers();
+}
+
+/** Method writes the built circuit into binary snapshot, which is loaded by build without parsing.
+	@param fname Name of the snapshot file.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::save( const std::string & fname ){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	CompiledCircuit compiled;
+	compiled.netlist = this->netlist;
+	for( const auto & input : this->input_columns ){
+		compiled.input_nodes.push_back( input.first );
+	}
+	compiled.input_indices = this->input_indices;
+	compiled.output_nodes = this->output_nodes;
+	compiled.output_indices = this->output_indices;
+	compiled.unconnected_nodes = this->unconnected;
+	std::string error = NetlistFile::write( fname, compiled );
+	if( error != "" ){
+		this->errors.push_back( error );
+		this->_good = false;
+		return false;
+	}
+	return true;
+}
+
+/** Method keeps only the given outputs of the built circuit, removing gates outside of their input cones. Input nodes are kept.
+	@param nodes Numbers of the kept output nodes, those which are not outputs of the circuit are reported and skipped.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::select_outputs( const std::vector< int > & nodes ){
 	if( !this->built ){
 		this->errors.push_back( "error: Circuit not built" );
 		this->_good = false;
 		return false;
 	}
-	for( const auto & set : this->input_sets ){
-		for( const auto & gate : this->gates ){
-			gate.second->evaluated = false;
+	for( int node : nodes ){
+		if( std::find( this->output_nodes.begin(), this->output_nodes.end(), node ) == this->output_nodes.end() ){
+			this->errors.push_back( "warning: ommiting selected output " + std::to_string( node ) + " - it is not an output of the circuit" );
 		}
-		for( const auto & input : set){
-			this->gates[input.first]->value = input.second;
+	}
+	//Kept outputs stay in ascending order of their nodes
+	std::vector< int > output_nodes;
+	std::vector< uint32_t > roots;
+	for( size_t column = 0; column < this->output_nodes.size(); column++ ){
+		if( std::find( nodes.begin(), nodes.end(), this->output_nodes[ column ] ) != nodes.end() ){
+			output_nodes.push_back( this->output_nodes[ column ] );
+			roots.push_back( this->output_indices[ column ] );
 		}
-		std::map<int, bool> output_set;
-		for( const auto & output : this->outputs ){
-			output_set[ output->input1 ] = output->evaluate( output );
+	}
+	if( output_nodes.empty() ){
+		this->errors.push_back( "error: none of the selected nodes is an output of the circuit" );
+		this->_good = false;
+		return false;
+	}
+
+	std::vector< uint32_t > kept( this->netlist.size(), 0 );
+	std::vector< uint32_t > cone;
+	this->netlist.cone( roots, kept, 1, cone );
+	std::fill( kept.begin(), kept.begin() + this->netlist.input_count, 1 );
+	Netlist selected;
+	std::vector< uint32_t > indices( this->netlist.size(), 0 );
+	std::vector< uint32_t > fanin;
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		if( !kept[ node ] ){
+			continue;
 		}
-		this->output_sets.push_back( output_set );
+		fanin.clear();
+		for( uint32_t i = 0; i < this->netlist.fanin_count( node ); i++ ){
+			//Input of flip-flop may not have an index yet, it is connected below
+			fanin.push_back( this->netlist.operations[ node ] == OPERATION_DFF ? 0 : indices[ this->netlist.input( node, i ) ] );
+		}
+		indices[ node ] = selected.add( this->netlist.operations[ node ], fanin, this->netlist.tables[ node ], this->netlist.nodes[ node ], this->netlist.levels[ node ] );
+	}
+	selected.input_count = this->netlist.input_count;
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		if( kept[ node ] && this->netlist.operations[ node ] == OPERATION_DFF ){
+			selected.inputs1[ indices[ node ] ] = indices[ this->netlist.inputs1[ node ] ];
+		}
+	}
+	selected.build_fanouts();
+	//Removed gates drive none of the kept outputs
+	for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+		if( !kept[ node ] ){
+			this->unconnected.push_back( this->netlist.nodes[ node ] );
+		}
+	}
+	std::sort( this->unconnected.begin(), this->unconnected.end() );
+	this->netlist = std::move( selected );
+	this->output_nodes = output_nodes;
+	this->output_indices.clear();
+	for( uint32_t root : roots ){
+		this->output_indices.push_back( indices[ root ] );
+	}
+	this->output_sets.reset( this->output_nodes.size() );
+	this->find_registers();
+	this->clusters.clear();
+	return true;
+}
+
+/** Method removes redundant logic from the built circuit: gates driving no output, structurally identical gates,
+	gates with constant, equal or complementary inputs and chains of negations.
+	@return Method returns true if the circuit has been optimized.
+*/
+bool Circuit::optimize(){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
 	}
+	this->netlist = Optimizer( this->netlist ).optimize( this->output_indices );
+	this->find_registers();
+	this->clusters.clear();
+	return true;
+}
 
-	return true; 
+/** Method compiles the built circuit to native code for the configured number of parallel vectors, evaluation then goes through the compiled code.
+	If the compilation fails, a warning is reported and the circuit keeps being evaluated by the interpreter.
+	@return Method returns true if the native code has been loaded.
+*/
+bool Circuit::compile_native(){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	std::string error = this->native.load( this->netlist, this->width / 64 );
+	if( error != "" ){
+		this->errors.push_back( "warning: evaluating without native code: " + error );
+		return false;
+	}
+	return true;
 }
 
-/** Method writes evaluated outputs into file.
-@param fname Name of the file where the output values are supposed to be stored.
-@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+/** Method reads delays of the gates and selects timing simulation, which evaluates sets one by one and changes gates their delay after their inputs.
+	Lines "<gate name> <delay>" set delay of every gate of the type, lines "<node> <delay>" set delay of the gate driving the node and take precedence,
+	other gates have delay 1. Delays are whole time units from 1 to 65535. It has to be called after the circuit is built and optimized.
+	@param fname Name of the file where the delays are stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
 */
-bool Circuit::writeOutputs( const std::string & fname ){
+bool Circuit::read_delays( const std::string & fname ){
+	//Bound of the delays, it keeps the timing wheel small
+	const int max_delay = 65535;
 	if( !this->built ){
 		this->errors.push_back( "error: Circuit not built" );
 		this->_good = false;
 		return false;
 	}
-	std::ofstream file( fname );
-	if( !file ){
-		this->errors.push_back( "error: Couldn't open output file for writing!" );
+	MappedFile file;
+	if( !file.open( fname ) ){
+		this->errors.push_back( "error: Couldn't open delays file for reading!" );
 		this->_good = false;
 		return false;
 	}
-	for( int i = 0; i < this->output_sets.size(); i++ ){
-		file<<"IN: ";
-		for( const auto & input : this->input_sets[i] ){
-			file<<input.first<<":"<<input.second<<" ";
+	std::vector< uint32_t > operation_delays( OPERATION_LATCH + 1, 1 );
+	std::map< int, uint32_t > node_delays;
+	this->counters.bytes_parsed += file.size();
+	Tokenizer tokenizer( file.data(), file.data() + file.size() );
+	while( tokenizer.next_line() ){
+		std::string_view name, token, rest;
+		if( !tokenizer.token( name ) ){
+			continue;
 		}
-		file<<"OUT: ";
-		for( const auto & output : this->output_sets[i] ){
-			file<<output.first<<":"<<output.second<<" ";
+		Operation operation;
+		int node, delay;
+		bool is_node = Tokenizer::number( name, node );
+		if( ( !is_node && !find_operation( name, operation ) ) || !tokenizer.token( token ) || !Tokenizer::number( token, delay ) || delay < 1 || delay > max_delay || tokenizer.token( rest ) ){
+			this->errors.push_back( fname + ": line: " + std::to_string( tokenizer.line() ) + " warning: ommiting line - incorrect delay" );
+			continue;
+		}
+		if( is_node ){
+			node_delays[ node ] = delay;
+		}else{
+			operation_delays[ operation ] = delay;
 		}
-		file<<std::endl;
 	}
 	file.close();
+
+	this->delays.assign( this->netlist.size(), 1 );
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		auto found = node_delays.find( this->netlist.nodes[ node ] );
+		if( found != node_delays.end() ){
+			this->delays[ node ] = found->second;
+		}else if( this->netlist.operations[ node ] < operation_delays.size() ){
+			this->delays[ node ] = operation_delays[ this->netlist.operations[ node ] ];
+		}
+	}
+	this->toggles.assign( this->netlist.size(), 0 );
+	this->glitches.assign( this->netlist.size(), 0 );
+	this->state.clear();
 	return true;
 }
 
-/**
-	@return Function returns vector containing descriptions of encountered errors.
+/** Method reads sets of inputs from the file and puts them into object's internal vector.
+	Files starting with the magic of the binary format are mapped into memory instead of being parsed.
+	@param fname Name of the file where the inputs are stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
 */
-std::vector<std::string> Circuit::get_errors(){
-	return this->errors;
+bool Circuit::readInputs( const std::string & fname ){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	if( VectorFile::is_binary( fname ) ){
+		VectorFile file;
+		std::string error = file.open( fname );
+		if( error != "" ){
+			this->errors.push_back( error );
+			this->_good = false;
+			return false;
+		}
+		this->read_binary_sets( file, fname, 0, file.size(), this->input_sets );
+		return true;
+	}
+	MappedFile file;
+	if( !file.open( fname ) ){
+		this->errors.push_back( "error: Couldn't open inputs file for reading!");
+		this->_good = false;
+		return false;
+	}
+
+	this->counters.bytes_parsed += file.size();
+	Tokenizer tokenizer( file.data(), file.data() + file.size() );
+	while( this->read_sets( tokenizer, fname, this->input_sets, SIZE_MAX ) );
+
+	file.close();
+	return true;
 }
 
-/**
-	@return Function returns last encountered error.
+/** Method reads sets of inputs from the text and appends them to the given set.
+	@param tokenizer Tokenizer of the text the inputs are read from.
+	@param fname Name of the file where the inputs are stored, used in warnings.
+	@param [in,out] sets Sets of input data the read sets are appended to.
+	@param limit Maximal number of sets to be read.
+	@return Method returns number of read sets.
 */
-std::string Circuit::get_last_error(){
-	return this->errors[ this->errors.size() - 1 ];
+size_t Circuit::read_sets( Tokenizer & tokenizer, const std::string & fname, VectorSet & sets, size_t limit ){
+	//Reading inputs from the file
+	size_t count = 0;
+	std::vector< int > unknown;
+	while( count < limit && tokenizer.next_line() ){
+		std::string_view input;
+		if( !tokenizer.token( input ) )
+			continue;
+		size_t set = sets.push_back();
+		count++;
+		unknown.clear();
+		do{
+			auto separator_position = input.find( ':' );
+			int node = 0;
+			int value = 0;
+			//Four-valued inputs may be given as X or Z, which are stored as undefined 0 and 1
+			std::string_view symbol = separator_position == std::string_view::npos ? "" : input.substr( separator_position + 1 );
+			bool unknown_value = this->four_valued && ( symbol == "X" || symbol == "x" || symbol == "Z" || symbol == "z" );
+			if( separator_position == std::string_view::npos || !Tokenizer::number( input.substr( 0, separator_position ), node ) || ( !unknown_value && !Tokenizer::number( symbol, value ) ) ){
+				this->errors.push_back( fname + ": line: " + std::to_string( tokenizer.line() ) + " warning: incorrect input: " + std::string( input ) );
+				continue;
+			}
+			//Checking if node is an input node
+			auto column = this->input_columns.find( node );
+			if( column == this->input_columns.end() ){
+				this->errors.push_back( fname + ": line: " + std::to_string( tokenizer.line() ) + " warning: incorrect input node: " + std::to_string( node )  ); 
+				continue;
+			}
+
+			if( unknown_value ){
+				sets.set( set, column->second, symbol == "Z" || symbol == "z", false );
+				unknown.push_back( column->second );
+				continue;
+			}
+			sets.set( set, column->second, value );
+		}while( tokenizer.token( input ) );
+
+		//Looking for input nodes not present in set of inputs
+		std::vector< int > missing_inputs;
+		for( const auto & input : this->input_columns ){
+			if( !sets.is_defined( set, input.second ) && std::find( unknown.begin(), unknown.end(), input.second ) == unknown.end() ){
+				missing_inputs.push_back(input.first);
+			}
+		}
+
+		if( missing_inputs.size() ){
+			std::string warning = fname + ": line: " + std::to_string( tokenizer.line() ) + "warning: following outputs have no defined value and will be " + ( this->four_valued ? "X: " : "defaulted to 0: " );
+			for( int i : missing_inputs ){
+				warning += std::to_string( i ) + " ";
+			}
+			this->errors.push_back( warning );
+		}
+	}
+	return count;
+}
+
+/** Method copies sets of inputs from the binary file and appends them to the given set.
+	@param file Mapped binary file with sets of inputs.
+	@param fname Name of the file where the inputs are stored, used in warnings.
+	@param first Index of the first set to be copied, it has to be a multiple of 64.
+	@param count Number of sets to be copied.
+	@param [in,out] sets Sets of input data the copied sets are appended to.
+*/
+void Circuit::read_binary_sets( const VectorFile & file, const std::string & fname, size_t first, size_t count, VectorSet & sets ){
+	//Matching nodes of the file with input columns, warnings are reported only with the first batch
+	std::vector< int > columns;
+	std::vector< bool > present( this->input_columns.size() );
+	for( int node : file.nodes() ){
+		auto column = this->input_columns.find( node );
+		if( column == this->input_columns.end() ){
+			if( first == 0 ){
+				this->errors.push_back( fname + ": warning: incorrect input node: " + std::to_string( node ) );
+			}
+			columns.push_back( -1 );
+			continue;
+		}
+		columns.push_back( column->second );
+		present[ column->second ] = true;
+	}
+	if( first == 0 && std::find( present.begin(), present.end(), false ) != present.end() ){
+		std::string warning = fname + ": warning: following inputs have no defined value and will be " + std::string( this->four_valued ? "X: " : "defaulted to 0: " );
+		for( const auto & input : this->input_columns ){
+			if( !present[ input.second ] ){
+				warning += std::to_string( input.first ) + " ";
+			}
+		}
+		this->errors.push_back( warning );
+	}
+
+	size_t start = sets.size();
+	if( start % 64 ){
+		//Sets are not aligned to blocks, copying bit by bit
+		for( size_t set = first; set < first + count; set++ ){
+			size_t index = sets.push_back();
+			const uint64_t * words = file.block( set / 64 );
+			for( size_t i = 0; i < columns.size(); i++ ){
+				if( columns[i] >= 0 ){
+					sets.set( index, columns[i], ( words[i] >> ( set % 64 ) ) & 1 );
+				}
+			}
+		}
+		return;
+	}
+	sets.resize( start + count );
+	for( size_t block = 0; block * 64 < count; block++ ){
+		const uint64_t * words = file.block( first / 64 + block );
+		uint64_t * values = sets.block_values( start / 64 + block );
+		uint64_t * defined = sets.block_defined( start / 64 + block );
+		uint64_t mask = count - block * 64 >= 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( count % 64 ) ) - 1;
+		for( size_t i = 0; i < columns.size(); i++ ){
+			if( columns[i] >= 0 ){
+				values[ columns[i] ] = words[i] & mask;
+				defined[ columns[i] ] = mask;
+			}
+		}
+	}
+}
+
+/** Method loads Word::size blocks of sets into values of the input nodes, blocks past the end are left empty.
+	@param input_sets Sets of input data.
+	@param first Index of the first loaded block.
+	@param [out] values Values of all nodes.
+*/
+template< typename Word >
+void Circuit::load_inputs( const VectorSet & input_sets, size_t first, std::vector< Word > & values ){
+	size_t blocks = input_sets.blocks();
+	for( int column = 0; column < input_sets.width(); column++ ){
+		int index = this->input_indices[ column ];
+		if( index < 0 ){
+			continue;
+		}
+		for( int i = 0; i < Word::size; i++ ){
+			bool loaded = first + i < blocks;
+			values[ index ].load( i, loaded ? input_sets.block_values( first + i )[ column ] : 0, loaded ? input_sets.block_defined( first + i )[ column ] : 0 );
+		}
+	}
+}
+
+/** Method evaluates every gate of the netlist once, by the native code if it is loaded and evaluates two-valued logic.
+	@param [in,out] values Values of all nodes, values of the input nodes and registers have to be set.
+*/
+template< typename Word >
+void Circuit::sweep( std::vector< Word > & values ){
+	if constexpr( std::is_same< Word, Lanes< Word::size > >::value ){
+		if( this->native.function() != NULL ){
+			this->native.function()( values[0].words );
+			return;
+		}
+	}
+	const uint8_t * operations = this->netlist.operations.data();
+	const uint32_t * inputs1 = this->netlist.inputs1.data();
+	const uint32_t * inputs2 = this->netlist.inputs2.data();
+	const uint32_t * fanin_offsets = this->netlist.fanin_offsets.data();
+	for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+		//Two-input gates are evaluated directly, the rest goes through the general kernel
+		if( fanin_offsets[ node ] == fanin_offsets[ node + 1 ] && operations[ node ] <= OPERATION_ONE ){
+			values[ node ] = evaluate_operation( operations[ node ], values[ inputs1[ node ] ], values[ inputs2[ node ] ] );
+		}else{
+			values[ node ] = this->netlist.evaluate( node, values.data() );
+		}
+	}
+}
+
+/** Method evaluates gates of the cluster once.
+	@param [in,out] values Values of all nodes, values of the input nodes have to be set.
+	@param nodes Indices of the evaluated gates, in topological order.
+*/
+template< typename Word >
+void Circuit::sweep_cluster( std::vector< Word > & values, const std::vector< uint32_t > & nodes ){
+	const uint8_t * operations = this->netlist.operations.data();
+	const uint32_t * inputs1 = this->netlist.inputs1.data();
+	const uint32_t * inputs2 = this->netlist.inputs2.data();
+	const uint32_t * fanin_offsets = this->netlist.fanin_offsets.data();
+	for( uint32_t node : nodes ){
+		if( fanin_offsets[ node ] == fanin_offsets[ node + 1 ] && operations[ node ] <= OPERATION_ONE ){
+			values[ node ] = evaluate_operation( operations[ node ], values[ inputs1[ node ] ], values[ inputs2[ node ] ] );
+		}else{
+			values[ node ] = this->netlist.evaluate( node, values.data() );
+		}
+	}
+}
+
+/** Method partitions outputs into balanced clusters with mostly disjoint input cones, one cluster per thread of the pool at most.
+	Outputs are taken from the biggest cone and every one goes to the cluster which is the smallest after adding gates of its cone missing in the cluster.
+*/
+void Circuit::partition_outputs(){
+	//Membership of a node in the clusters is kept as a bit mask
+	const size_t max_clusters = 64;
+	size_t count = std::min( { size_t( this->pool->size() ), this->output_indices.size(), max_clusters } );
+	std::vector< std::vector< uint32_t > > cones( this->output_indices.size() );
+	std::vector< uint32_t > marks( this->netlist.size(), 0 );
+	size_t total = 0;
+	for( size_t column = 0; column < this->output_indices.size(); column++ ){
+		this->netlist.cone( { uint32_t( this->output_indices[ column ] ) }, marks, column + 1, cones[ column ] );
+		cones[ column ].erase( std::remove_if( cones[ column ].begin(), cones[ column ].end(), [ this ]( uint32_t node ){
+			return node < this->netlist.input_count;
+		} ), cones[ column ].end() );
+		//Cones overlapping that much can't be split without repeating most of the circuit, a single cluster holds everything then
+		total += cones[ column ].size();
+		if( total > count * this->gate_count() ){
+			this->clusters.assign( 1, Cluster() );
+			for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+				this->clusters[0].nodes.push_back( node );
+			}
+			for( size_t column = 0; column < this->output_indices.size(); column++ ){
+				this->clusters[0].columns.push_back( column );
+			}
+			return;
+		}
+	}
+	std::vector< size_t > order( cones.size() );
+	for( size_t column = 0; column < order.size(); column++ ){
+		order[ column ] = column;
+	}
+	std::stable_sort( order.begin(), order.end(), [ &cones ]( size_t a, size_t b ){
+		return cones[a].size() > cones[b].size();
+	} );
+
+	std::vector< uint64_t > members( this->netlist.size(), 0 );
+	std::vector< size_t > sizes( count, 0 );
+	std::vector< size_t > shared( count );
+	this->clusters.assign( count, Cluster() );
+	for( size_t column : order ){
+		std::fill( shared.begin(), shared.end(), 0 );
+		for( uint32_t node : cones[ column ] ){
+			for( uint64_t clusters = members[ node ]; clusters; clusters &= clusters - 1 ){
+				shared[ __builtin_ctzll( clusters ) ]++;
+			}
+		}
+		size_t best = 0;
+		for( size_t cluster = 1; cluster < count; cluster++ ){
+			if( sizes[ cluster ] - shared[ cluster ] < sizes[ best ] - shared[ best ] ){
+				best = cluster;
+			}
+		}
+		for( uint32_t node : cones[ column ] ){
+			members[ node ] |= uint64_t( 1 ) << best;
+		}
+		sizes[ best ] += cones[ column ].size() - shared[ best ];
+		this->clusters[ best ].columns.push_back( column );
+	}
+	for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+		for( uint64_t clusters = members[ node ]; clusters; clusters &= clusters - 1 ){
+			this->clusters[ __builtin_ctzll( clusters ) ].nodes.push_back( node );
+		}
+	}
+}
+
+/**
+	@return Method returns for every output column the input column read by it directly, -1 for outputs driven by gates.
+*/
+std::vector< int > Circuit::direct_inputs(){
+	std::vector< int > input_columns( this->netlist.input_count, -1 );
+	for( size_t column = 0; column < this->input_indices.size(); column++ ){
+		if( this->input_indices[ column ] >= 0 ){
+			input_columns[ this->input_indices[ column ] ] = column;
+		}
+	}
+	std::vector< int > columns;
+	for( int index : this->output_indices ){
+		columns.push_back( uint32_t( index ) < this->netlist.input_count ? input_columns[ index ] : -1 );
+	}
+	return columns;
+}
+
+/** Method evaluates output values for given sets of input data, packing Word::size * 64 sets into every bit-parallel word.
+	Groups of sets are distributed between threads of the pool, each group writes its own blocks of outputs so their order does not depend on scheduling.
+	@param input_sets Sets of input data.
+	@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+*/
+template< typename Word >
+void Circuit::evaluate_lanes( const VectorSet & input_sets, VectorSet & output_sets ){
+	const int N = Word::size;
+	//Every worker has its own values, the circuit structure is shared read only
+	std::vector< std::vector< Word > > worker_values( this->pool->size(), std::vector< Word >( this->netlist.size() ) );
+	std::vector< int > direct = this->direct_inputs();
+	size_t blocks = input_sets.blocks();
+	output_sets.resize( input_sets.size() );
+	size_t groups = ( blocks + N - 1 ) / N;
+	//Activity is counted into counters of every worker and summed at the end
+	const bool counted = std::is_same< Word, Lanes< N > >::value && this->activity;
+	std::vector< std::vector< uint64_t > > worker_ones, worker_toggles;
+	if( counted ){
+		worker_ones.assign( this->pool->size(), std::vector< uint64_t >( this->netlist.size(), 0 ) );
+		worker_toggles.assign( this->pool->size(), std::vector< uint64_t >( this->netlist.size(), 0 ) );
+	}
+	//Values of the traced nodes are copied into disjoint blocks of the chunk by the workers
+	const bool tracing = std::is_same< Word, Lanes< N > >::value && this->waveform;
+	WaveformChunk chunk;
+	if( tracing ){
+		chunk.first = this->traced_sets;
+		chunk.count = input_sets.size();
+		chunk.words.resize( this->traced.size() * blocks );
+	}
+	//Too few groups leave threads idle, then clusters of outputs are evaluated on separate threads
+	std::vector< size_t > all_columns( this->output_indices.size() );
+	for( size_t column = 0; column < all_columns.size(); column++ ){
+		all_columns[ column ] = column;
+	}
+	bool clustered = groups < size_t( this->pool->size() ) && !counted && !tracing && this->native.function() == NULL;
+	if( clustered && this->clusters.empty() ){
+		this->partition_outputs();
+	}
+	size_t parts = clustered ? this->clusters.size() : 1;
+	uint64_t evaluated = 0;
+	size_t largest = 0;
+	for( size_t part = 0; clustered && part < parts; part++ ){
+		evaluated += this->clusters[ part ].nodes.size();
+		largest = std::max( largest, this->clusters[ part ].nodes.size() );
+	}
+	//Clusters pay off only if the busiest thread sweeps fewer gates than a single sweep of the whole circuit
+	if( clustered && ( groups * parts + this->pool->size() - 1 ) / this->pool->size() * largest >= this->gate_count() ){
+		clustered = false;
+		parts = 1;
+	}
+	this->counters.gates_evaluated += ( clustered ? evaluated : uint64_t( this->gate_count() ) ) * input_sets.size();
+	this->pool->run( groups * parts, [ & ]( size_t task, int worker ){
+		std::vector< Word > & values = worker_values[ worker ];
+		size_t first = task / parts * N;
+		const std::vector< size_t > & columns = clustered ? this->clusters[ task % parts ].columns : all_columns;
+		this->load_inputs( input_sets, first, values );
+		if( clustered ){
+			this->sweep_cluster( values, this->clusters[ task % parts ].nodes );
+		}else{
+			this->sweep( values );
+		}
+		if constexpr( std::is_same< Word, Lanes< N > >::value ){
+			if( counted ){
+				this->count_activity( values, first, input_sets.size(), worker_ones[ worker ], worker_toggles[ worker ] );
+			}
+			if( tracing ){
+				for( size_t k = 0; k < this->traced.size(); k++ ){
+					for( int i = 0; i < N && first + i < blocks; i++ ){
+						chunk.words[ k * blocks + first + i ] = values[ this->traced[k] ].words[i];
+					}
+				}
+			}
+		}
+		for( int i = 0; i < N && first + i < blocks; i++ ){
+			uint64_t * outputs = output_sets.block_values( first + i );
+			uint64_t * defined = output_sets.block_defined( first + i );
+			//Marking as defined only bits belonging to existing vectors
+			uint64_t mask = first + i + 1 < blocks || input_sets.size() % 64 == 0 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( input_sets.size() % 64 ) ) - 1;
+			for( size_t column : columns ){
+				uint64_t value, known;
+				if( this->four_valued && direct[ column ] >= 0 ){
+					//High impedance passes from input node straight to the output
+					value = input_sets.block_values( first + i )[ direct[ column ] ];
+					known = input_sets.block_defined( first + i )[ direct[ column ] ];
+				}else{
+					values[ this->output_indices[ column ] ].store( i, value, known );
+				}
+				outputs[ column ] = value & mask;
+				defined[ column ] = known & mask;
+			}
+		}
+	} );
+	if constexpr( std::is_same< Word, Lanes< N > >::value ){
+		if( counted ){
+			if( this->activity_ones.size() != this->netlist.size() ){
+				this->activity_ones.assign( this->netlist.size(), 0 );
+				this->activity_toggles.assign( this->netlist.size(), 0 );
+				this->activity_last.reset( input_sets.width() );
+			}
+			for( int worker = 0; worker < this->pool->size(); worker++ ){
+				for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+					this->activity_ones[ node ] += worker_ones[ worker ][ node ];
+					this->activity_toggles[ node ] += worker_toggles[ worker ][ node ];
+				}
+			}
+			this->count_boundaries< Word >( input_sets );
+			this->activity_sets += input_sets.size();
+		}
+		if( tracing ){
+			this->traced_sets += input_sets.size();
+			this->waveform->write( std::move( chunk ) );
+		}
+	}
+}
+
+/** Method counts ones and changes between consecutive sets of every node within a group of sets evaluated together.
+	@param values Values of all nodes for the group.
+	@param first Index of the first block of the group.
+	@param count Number of all evaluated sets.
+	@param [in,out] ones Number of sets where every node was 1.
+	@param [in,out] toggles Number of changes of every node between consecutive sets.
+*/
+template< typename Word >
+void Circuit::count_activity( const std::vector< Word > & values, size_t first, size_t count, std::vector< uint64_t > & ones, std::vector< uint64_t > & toggles ){
+	const int N = Word::size;
+	uint64_t valid[ N ];
+	for( int i = 0; i < N; i++ ){
+		size_t block = first + i;
+		valid[i] = block * 64 >= count ? 0 : ( block + 1 ) * 64 <= count ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( count % 64 ) ) - 1;
+	}
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		const uint64_t * words = values[ node ].words;
+		//Every set is compared with the previous one, shifted in from the lower word, the first set of the group is compared with itself
+		uint64_t previous = words[0] & 1;
+		for( int i = 0; i < N; i++ ){
+			uint64_t shifted = ( words[i] << 1 ) | previous;
+			previous = words[i] >> 63;
+			ones[ node ] += __builtin_popcountll( words[i] & valid[i] );
+			toggles[ node ] += __builtin_popcountll( ( words[i] ^ shifted ) & valid[i] );
+		}
+	}
+}
+
+/** Method counts changes of every node between consecutive sets evaluated in different groups, or in the previous call.
+	Last and first sets of neighbouring groups are packed into two sets of their own and evaluated again, so the groups need not be evaluated in order.
+	@param input_sets Sets of input data.
+*/
+template< typename Word >
+void Circuit::count_boundaries( const VectorSet & input_sets ){
+	const int N = Word::size;
+	size_t group = size_t( N ) * 64;
+	auto copy = []( VectorSet & sets, const VectorSet & source, size_t set ){
+		size_t copied = sets.push_back();
+		for( int column = 0; column < source.width(); column++ ){
+			sets.set( copied, column, source.value( set, column ), source.is_defined( set, column ) );
+		}
+	};
+	VectorSet before, after;
+	before.reset( input_sets.width() );
+	after.reset( input_sets.width() );
+	if( this->activity_last.size() && input_sets.size() ){
+		copy( before, this->activity_last, 0 );
+		copy( after, input_sets, 0 );
+	}
+	for( size_t set = group; set < input_sets.size(); set += group ){
+		copy( before, input_sets, set - 1 );
+		copy( after, input_sets, set );
+	}
+	if( input_sets.size() ){
+		this->activity_last.reset( input_sets.width() );
+		copy( this->activity_last, input_sets, input_sets.size() - 1 );
+	}
+
+	std::vector< Word > previous( this->netlist.size() );
+	std::vector< Word > values( this->netlist.size() );
+	for( size_t first = 0; first < before.blocks(); first += N ){
+		this->load_inputs( before, first, previous );
+		this->sweep( previous );
+		this->load_inputs( after, first, values );
+		this->sweep( values );
+		for( int i = 0; i < N && first + i < before.blocks(); i++ ){
+			uint64_t valid = first + i + 1 < before.blocks() || before.size() % 64 == 0 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( before.size() % 64 ) ) - 1;
+			for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+				this->activity_toggles[ node ] += __builtin_popcountll( ( previous[ node ].words[i] ^ values[ node ].words[i] ) & valid );
+			}
+		}
+	}
+}
+
+/** Method evaluates sequential circuit, set i is clock cycle i / testbenches of testbench i % testbenches.
+	Every lane of the bit-parallel words simulates its own testbench, groups of Word::size * 64 testbenches are distributed between threads of the pool.
+	Combinational logic is evaluated once per cycle, then flip-flops take values of their inputs. Values of the registers are kept for the next call.
+	@param input_sets Sets of input data.
+	@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+*/
+template< typename Word >
+void Circuit::evaluate_cycles( const VectorSet & input_sets, VectorSet & output_sets ){
+	const int N = Word::size;
+	size_t testbenches = this->testbenches;
+	size_t registers = this->registers.size();
+	size_t blocks = ( testbenches + 63 ) / 64;
+	size_t groups = ( blocks + N - 1 ) / N;
+	size_t cycles = ( input_sets.size() + testbenches - 1 ) / testbenches;
+	size_t outputs = this->output_indices.size();
+	//Registers are kept as packed values and flags of definition, undefined 0 is the initial value in both modes
+	if( this->register_state.size() != blocks * registers * 2 ){
+		this->register_state.assign( blocks * registers * 2, 0 );
+	}
+	std::vector< std::vector< Word > > worker_values( this->pool->size(), std::vector< Word >( this->netlist.size() ) );
+	std::vector< int > direct = this->direct_inputs();
+	//Groups share words of the output sets, so their outputs are collected separately and stored once all groups are done
+	std::vector< std::vector< uint64_t > > group_outputs( groups, std::vector< uint64_t >( cycles * outputs * N * 2 ) );
+	output_sets.resize( input_sets.size() );
+	this->counters.gates_evaluated += uint64_t( this->gate_count() ) * input_sets.size();
+
+	//Number of testbenches in the block which have a set in the cycle
+	auto active = [ & ]( size_t block, size_t cycle ){
+		size_t first = cycle * testbenches + block * 64;
+		return first >= input_sets.size() ? 0 : std::min( { testbenches - block * 64, input_sets.size() - first, size_t( 64 ) } );
+	};
+	this->pool->run( groups, [ & ]( size_t group, int worker ){
+		std::vector< Word > & values = worker_values[ worker ];
+		std::vector< Word > held( registers );
+		size_t first = group * N;
+		for( size_t r = 0; r < registers; r++ ){
+			for( int i = 0; i < N; i++ ){
+				const uint64_t * state = this->register_state.data() + ( ( first + i ) * registers + r ) * 2;
+				values[ this->registers[r] ].load( i, first + i < blocks ? state[0] : 0, first + i < blocks ? state[1] : 0 );
+			}
+		}
+		for( size_t cycle = 0; cycle < cycles; cycle++ ){
+			//Lanes of testbenches without a set in this cycle keep their registers unchanged
+			Word mask;
+			bool partial = false;
+			for( int i = 0; i < N; i++ ){
+				size_t count = first + i < blocks ? active( first + i, cycle ) : 0;
+				mask.load( i, count == 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << count ) - 1, ~uint64_t( 0 ) );
+				partial = partial || ( first + i < blocks && count < 64 && count < testbenches - ( first + i ) * 64 );
+			}
+			for( int column = 0; column < input_sets.width(); column++ ){
+				int index = this->input_indices[ column ];
+				if( index < 0 ){
+					continue;
+				}
+				for( int i = 0; i < N; i++ ){
+					uint64_t value = 0, defined = 0;
+					if( first + i < blocks ){
+						input_sets.word( cycle * testbenches + ( first + i ) * 64, column, value, defined );
+					}
+					values[ index ].load( i, value, defined );
+				}
+			}
+			if( partial ){
+				for( size_t r = 0; r < registers; r++ ){
+					held[r] = values[ this->registers[r] ];
+				}
+			}
+			this->sweep( values );
+			uint64_t * stored = group_outputs[ group ].data() + cycle * outputs * N * 2;
+			for( size_t column = 0; column < outputs; column++ ){
+				for( int i = 0; i < N; i++ ){
+					uint64_t * pair = stored + ( column * N + i ) * 2;
+					if( this->four_valued && direct[ column ] >= 0 ){
+						//High impedance passes from input node straight to the output
+						input_sets.word( cycle * testbenches + ( first + i ) * 64, direct[ column ], pair[0], pair[1] );
+					}else{
+						values[ this->output_indices[ column ] ].store( i, pair[0], pair[1] );
+					}
+				}
+			}
+			//Clock edge, inputs of all flip-flops are sampled before any of them changes
+			for( size_t r = 0; r < registers; r++ ){
+				uint32_t node = this->registers[r];
+				if( this->netlist.operations[ node ] == OPERATION_DFF ){
+					held[r] = partial ? evaluate_mux( mask, held[r], values[ this->netlist.inputs1[ node ] ] ) : values[ this->netlist.inputs1[ node ] ];
+				}else if( partial ){
+					held[r] = evaluate_mux( mask, held[r], values[ node ] );
+				}else{
+					held[r] = values[ node ];
+				}
+			}
+			for( size_t r = 0; r < registers; r++ ){
+				values[ this->registers[r] ] = held[r];
+			}
+		}
+		for( size_t r = 0; r < registers; r++ ){
+			for( int i = 0; i < N && first + i < blocks; i++ ){
+				uint64_t * state = this->register_state.data() + ( ( first + i ) * registers + r ) * 2;
+				values[ this->registers[r] ].store( i, state[0], state[1] );
+			}
+		}
+	} );
+
+	for( size_t group = 0; group < groups; group++ ){
+		for( size_t cycle = 0; cycle < cycles; cycle++ ){
+			const uint64_t * stored = group_outputs[ group ].data() + cycle * outputs * N * 2;
+			for( int i = 0; i < N && group * N + i < blocks; i++ ){
+				size_t block = group * N + i;
+				int count = active( block, cycle );
+				for( size_t column = 0; column < outputs && count; column++ ){
+					const uint64_t * pair = stored + ( column * N + i ) * 2;
+					output_sets.set_word( cycle * testbenches + block * 64, column, pair[0], pair[1], count );
+				}
+			}
+		}
+	}
+}
+
+/** Method evaluates sets bit-parallel with the word type, sequential circuits clock by clock.
+	@param input_sets Sets of input data.
+	@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+*/
+template< typename Word >
+void Circuit::evaluate_parallel( const VectorSet & input_sets, VectorSet & output_sets ){
+	if( this->registers.empty() ){
+		this->evaluate_lanes< Word >( input_sets, output_sets );
+	}else{
+		this->evaluate_cycles< Word >( input_sets, output_sets );
+	}
+}
+
+/** Method evaluates output values for given sets of input data one by one, keeping values of all nodes between the sets.
+	Only fanouts of nodes whose value has changed are evaluated, in order of their levels, and propagation stops at gates whose value stays the same.
+	Every set is a clock cycle of a single testbench, flip-flops take values of their inputs after it.
+	@param input_sets Sets of input data.
+	@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+*/
+void Circuit::evaluate_events( const VectorSet & input_sets, VectorSet & output_sets ){
+	const uint32_t * levels = this->netlist.levels.data();
+	const uint32_t * fanout_offsets = this->netlist.fanout_offsets.data();
+	const uint32_t * fanouts = this->netlist.fanouts.data();
+
+	//Every node starts at 0 and every gate is scheduled for the first set, so latches and flip-flops keep their initial 0 until the first set evaluates them
+	if( this->state.size() != this->netlist.size() ){
+		this->state.assign( this->netlist.size(), 0 );
+		this->scheduled.assign( this->netlist.size(), false );
+		this->events.assign( this->netlist.depth() + 1, std::vector< uint32_t >() );
+		for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+			this->scheduled[ node ] = true;
+			this->events[ levels[ node ] ].push_back( node );
+		}
+	}
+
+	auto schedule_fanouts = [ & ]( uint32_t node ){
+		for( uint32_t i = fanout_offsets[ node ]; i < fanout_offsets[ node + 1 ]; i++ ){
+			uint32_t fanout = fanouts[i];
+			if( !this->scheduled[ fanout ] ){
+				this->scheduled[ fanout ] = true;
+				this->events[ levels[ fanout ] ].push_back( fanout );
+			}
+		}
+	};
+
+	uint64_t evaluated = 0;
+	std::vector< uint8_t > sampled;
+	output_sets.resize( input_sets.size() );
+	for( size_t set = 0; set < input_sets.size(); set++ ){
+		for( int column = 0; column < input_sets.width(); column++ ){
+			int index = this->input_indices[ column ];
+			if( index < 0 ){
+				continue;
+			}
+			uint8_t value = input_sets.is_defined( set, column ) && input_sets.value( set, column ) ? 0xFF : 0;
+			if( this->state[ index ] != value ){
+				this->state[ index ] = value;
+				schedule_fanouts( index );
+			}
+		}
+		//Events are processed level by level, so every gate is evaluated at most once per set
+		for( auto & level : this->events ){
+			evaluated += level.size();
+			for( uint32_t node : level ){
+				this->scheduled[ node ] = false;
+				uint8_t value = this->netlist.evaluate( node, this->state.data() );
+				if( value != this->state[ node ] ){
+					this->state[ node ] = value;
+					schedule_fanouts( node );
+				}
+			}
+			level.clear();
+		}
+		for( size_t column = 0; column < this->output_indices.size(); column++ ){
+			output_sets.set( set, column, this->state[ this->output_indices[ column ] ] );
+		}
+		//Flip-flops which change at the clock edge schedule their fanouts for the next set
+		sampled.clear();
+		for( uint32_t node : this->registers ){
+			sampled.push_back( this->state[ this->netlist.inputs1[ node ] ] );
+		}
+		for( size_t r = 0; r < this->registers.size(); r++ ){
+			uint32_t node = this->registers[r];
+			if( this->netlist.operations[ node ] == OPERATION_DFF && this->state[ node ] != sampled[r] ){
+				this->state[ node ] = sampled[r];
+				schedule_fanouts( node );
+			}
+		}
+	}
+	this->counters.gates_evaluated += evaluated;
+	this->counters.gates_skipped += uint64_t( this->gate_count() ) * input_sets.size() - evaluated;
+}
+
+/** Method evaluates sets one by one with delays of the gates, keeping values of all nodes between the sets.
+	The first set starts settled, inputs and flip-flops change at time 0 of every later set, gate evaluated at time t after change of its input changes its output at time t + its delay.
+	Changes are kept in a timing wheel and every set lasts until no change is waiting, settle times, path depths, toggles and glitches are recorded.
+	@param input_sets Sets of input data.
+	@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+*/
+void Circuit::evaluate_timing( const VectorSet & input_sets, VectorSet & output_sets ){
+	const uint32_t * fanout_offsets = this->netlist.fanout_offsets.data();
+	const uint32_t * fanouts = this->netlist.fanouts.data();
+	const uint32_t * delays = this->delays.data();
+
+	//State of the first set is obtained by zero delay sweep with its inputs, latches and flip-flops start at 0 and flip-flops are clocked only between sets
+	bool clocked = this->state.size() == this->netlist.size();
+	if( !clocked ){
+		this->state.assign( this->netlist.size(), 0 );
+		this->scheduled.assign( this->netlist.size(), false );
+		for( int column = 0; column < input_sets.width() && input_sets.size(); column++ ){
+			int index = this->input_indices[ column ];
+			if( index >= 0 ){
+				this->state[ index ] = input_sets.is_defined( 0, column ) && input_sets.value( 0, column ) ? 0xFF : 0;
+			}
+		}
+		for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+			this->state[ node ] = this->netlist.evaluate( node, this->state.data() );
+		}
+	}
+	std::vector< uint8_t > projected( this->state );			//Value of every node after all its scheduled changes
+	std::vector< uint32_t > depths( this->netlist.size(), 0 );	//Length of the chain of changes causing the last change of every node
+	std::vector< uint32_t > triggers( this->netlist.size(), 0 );//Length of the longest chain of changes reaching every triggered gate
+	std::vector< uint64_t > change_times( this->netlist.size(), 0 );
+	std::vector< uint32_t > set_toggles( this->netlist.size(), 0 );
+	std::vector< uint32_t > toggled;
+	std::vector< uint32_t > triggered;
+	std::vector< uint8_t > sampled;
+	TimingWheel wheel( *std::max_element( this->delays.begin(), this->delays.end() ) );
+
+	auto change = [ & ]( uint32_t node, uint8_t value, uint32_t depth ){
+		this->state[ node ] = value;
+		depths[ node ] = depth;
+		change_times[ node ] = wheel.time();
+		if( set_toggles[ node ]++ == 0 ){
+			toggled.push_back( node );
+		}
+		for( uint32_t i = fanout_offsets[ node ]; i < fanout_offsets[ node + 1 ]; i++ ){
+			uint32_t fanout = fanouts[i];
+			if( !this->scheduled[ fanout ] ){
+				this->scheduled[ fanout ] = true;
+				triggered.push_back( fanout );
+				triggers[ fanout ] = depth;
+			}else{
+				triggers[ fanout ] = std::max( triggers[ fanout ], depth );
+			}
+		}
+	};
+	//Gates are evaluated once all changes of the current time are done, only changes of their final values are scheduled (transport delay)
+	uint64_t evaluated = 0;
+	auto evaluate_triggered = [ & ](){
+		for( uint32_t node : triggered ){
+			this->scheduled[ node ] = false;
+			uint8_t value = this->netlist.evaluate( node, this->state.data() );
+			if( value != projected[ node ] ){
+				projected[ node ] = value;
+				wheel.schedule( delays[ node ], { node, value, triggers[ node ] + 1 } );
+			}
+		}
+		evaluated += triggered.size();
+		triggered.clear();
+	};
+
+	uint64_t events = 0;
+	size_t outputs = this->output_indices.size();
+	output_sets.resize( input_sets.size() );
+	this->settle_times.assign( input_sets.size() * outputs, 0 );
+	this->path_depths.assign( input_sets.size(), 0 );
+	for( size_t set = 0; set < input_sets.size(); set++ ){
+		wheel.restart();
+		//Flip-flops take values their inputs settled at in the previous set, all of them are sampled before any changes
+		sampled.clear();
+		for( uint32_t node : this->registers ){
+			sampled.push_back( this->state[ this->netlist.inputs1[ node ] ] );
+		}
+		for( size_t r = 0; r < this->registers.size() && clocked; r++ ){
+			uint32_t node = this->registers[r];
+			if( this->netlist.operations[ node ] == OPERATION_DFF && this->state[ node ] != sampled[r] ){
+				projected[ node ] = sampled[r];
+				change( node, sampled[r], 0 );
+			}
+		}
+		clocked = true;
+		for( int column = 0; column < input_sets.width(); column++ ){
+			int index = this->input_indices[ column ];
+			if( index < 0 ){
+				continue;
+			}
+			uint8_t value = input_sets.is_defined( set, column ) && input_sets.value( set, column ) ? 0xFF : 0;
+			if( this->state[ index ] != value ){
+				projected[ index ] = value;
+				change( index, value, 0 );
+			}
+		}
+		evaluate_triggered();
+		while( !wheel.empty() ){
+			std::vector< TimedEvent > & slot = wheel.advance();
+			events += slot.size();
+			for( const TimedEvent & event : slot ){
+				change( event.node, event.value, event.depth );
+			}
+			slot.clear();
+			evaluate_triggered();
+		}
+
+		for( size_t column = 0; column < outputs; column++ ){
+			uint32_t index = this->output_indices[ column ];
+			output_sets.set( set, column, this->state[ index ] );
+			if( set_toggles[ index ] ){
+				this->settle_times[ set * outputs + column ] = change_times[ index ];
+				this->path_depths[ set ] = std::max( this->path_depths[ set ], depths[ index ] );
+			}
+		}
+		//Every pair of changes beyond the settled one is a pulse
+		for( uint32_t node : toggled ){
+			this->toggles[ node ] += set_toggles[ node ];
+			this->glitches[ node ] += set_toggles[ node ] / 2;
+			set_toggles[ node ] = 0;
+		}
+		toggled.clear();
+	}
+	this->counters.gates_evaluated += evaluated;
+	this->counters.events += events;
+}
+
+/** Method finds the first set detecting every fault by parallel-pattern single-fault propagation.
+	Good values of Word::size * 64 sets are evaluated by one sweep, then every fault not detected by earlier sets is injected and propagated
+	only through gates whose values differ from the good ones. Detected faults are dropped, remaining faults are partitioned between threads of the pool.
+	@param input_sets Sets of input data.
+	@param [in,out] faults Faults of the circuit, detecting sets are filled in.
+*/
+template< typename Word >
+void Circuit::simulate_faults( const VectorSet & input_sets, std::vector< Fault > & faults ){
+	//Number of chunks of faults per worker, so stealing evens out faults propagating further than others
+	const size_t chunks_per_worker = 8;
+	const int N = Word::size;
+	const uint32_t * levels = this->netlist.levels.data();
+	const uint32_t * fanout_offsets = this->netlist.fanout_offsets.data();
+	const uint32_t * fanouts = this->netlist.fanouts.data();
+
+	/**
+	Structure holding values and events of a single worker, faulty values differ from the good ones only while a fault is propagated.
+	*/
+	struct Worker{
+		std::vector< Word > values;/**< Faulty values of all nodes*/
+		std::vector< bool > scheduled;/**< Flags set for nodes waiting for evaluation*/
+		std::vector< std::vector< uint32_t > > events;/**< Nodes waiting for evaluation, grouped by level*/
+		std::vector< uint32_t > changed;/**< Nodes whose faulty values differ from the good ones*/
+		size_t loaded = SIZE_MAX;/**< First block of the sets whose good values are copied into values*/
+		uint64_t evaluated = 0;/**< Number of gates evaluated by the worker*/
+	};
+	std::vector< Worker > workers( this->pool->size() );
+	for( Worker & worker : workers ){
+		worker.scheduled.assign( this->netlist.size(), false );
+		worker.events.assign( this->netlist.depth() + 1, std::vector< uint32_t >() );
+	}
+	std::vector< bool > observed( this->netlist.size(), false );
+	for( int index : this->output_indices ){
+		observed[ index ] = true;
+	}
+
+	std::vector< size_t > remaining( faults.size() );
+	std::iota( remaining.begin(), remaining.end(), 0 );
+	std::vector< Word > good( this->netlist.size() );
+	size_t blocks = input_sets.blocks();
+	for( size_t first = 0; first < blocks && !remaining.empty(); first += N ){
+		//Good values of the group, bits of vectors past the end are masked out of detection
+		Word valid;
+		this->load_inputs( input_sets, first, good );
+		for( int i = 0; i < N; i++ ){
+			valid.words[i] = first + i >= blocks ? 0 : first + i + 1 < blocks || input_sets.size() % 64 == 0 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( input_sets.size() % 64 ) ) - 1;
+		}
+		this->sweep( good );
+		this->counters.gates_evaluated += uint64_t( this->gate_count() ) * std::min( input_sets.size() - first * 64, size_t( N ) * 64 );
+
+		size_t chunk = std::max( remaining.size() / ( this->pool->size() * chunks_per_worker ), size_t( 1 ) );
+		this->pool->run( ( remaining.size() + chunk - 1 ) / chunk, [ & ]( size_t task, int index ){
+			Worker & worker = workers[ index ];
+			if( worker.loaded != first ){
+				worker.values = good;
+				worker.loaded = first;
+			}
+			size_t pending = 0;
+			auto schedule_fanouts = [ & ]( uint32_t node ){
+				for( uint32_t i = fanout_offsets[ node ]; i < fanout_offsets[ node + 1 ]; i++ ){
+					uint32_t fanout = fanouts[i];
+					if( !worker.scheduled[ fanout ] ){
+						worker.scheduled[ fanout ] = true;
+						worker.events[ levels[ fanout ] ].push_back( fanout );
+						pending++;
+					}
+				}
+			};
+			for( size_t f = task * chunk; f < std::min( ( task + 1 ) * chunk, remaining.size() ); f++ ){
+				Fault & fault = faults[ remaining[f] ];
+				Word stuck = Word::broadcast( fault.value );
+				//Fault not activated by any set of the group can't be detected by it
+				if( !( ( stuck ^ good[ fault.node ] ) & valid ).any() ){
+					continue;
+				}
+				worker.values[ fault.node ] = stuck;
+				worker.changed.push_back( fault.node );
+				schedule_fanouts( fault.node );
+				//Events are processed level by level, propagation stops where faulty values match the good ones
+				for( uint32_t level = levels[ fault.node ] + 1; pending; level++ ){
+					worker.evaluated += worker.events[ level ].size();
+					pending -= worker.events[ level ].size();
+					for( uint32_t node : worker.events[ level ] ){
+						worker.scheduled[ node ] = false;
+						Word value = this->netlist.evaluate( node, worker.values.data() );
+						if( ( value ^ worker.values[ node ] ).any() ){
+							worker.values[ node ] = value;
+							worker.changed.push_back( node );
+							schedule_fanouts( node );
+						}
+					}
+					worker.events[ level ].clear();
+				}
+				Word difference = Word::broadcast( false );
+				for( uint32_t node : worker.changed ){
+					if( observed[ node ] ){
+						difference = difference | ( worker.values[ node ] ^ good[ node ] );
+					}
+					worker.values[ node ] = good[ node ];
+				}
+				worker.changed.clear();
+				difference = difference & valid;
+				for( int i = 0; i < N; i++ ){
+					if( difference.words[i] ){
+						fault.detected = ( first + i ) * 64 + __builtin_ctzll( difference.words[i] );
+						break;
+					}
+				}
+			}
+		} );
+		//Dropping detected faults, later sets can't detect them earlier
+		remaining.erase( std::remove_if( remaining.begin(), remaining.end(), [ & ]( size_t f ){
+			return faults[f].detected != UINT64_MAX;
+		} ), remaining.end() );
+	}
+	for( const Worker & worker : workers ){
+		this->counters.gates_evaluated += worker.evaluated;
+	}
+}
+
+/** Method evaluates output values for each set of input data and stores them in object's internal vector.
+@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::evaluate(){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	this->evaluate_sets( this->input_sets, this->output_sets );
+	return true; 
+}
+
+/** Method evaluates output values for given sets of input data using configured number of parallel vectors.
+	@param input_sets Sets of input data.
+	@param [out] output_sets Sets of evaluated output data.
+*/
+void Circuit::evaluate_sets( const VectorSet & input_sets, VectorSet & output_sets ){
+	this->counters.vectors += input_sets.size();
+	if( !this->delays.empty() ){
+		this->evaluate_timing( input_sets, output_sets );
+	}else if( this->event_driven && this->testbenches == 1 && !this->four_valued ){
+		this->evaluate_events( input_sets, output_sets );
+	}else if( this->four_valued ){
+		if( this->width == 512 ){
+			this->evaluate_parallel< FourValued< Lanes< 8 > > >( input_sets, output_sets );
+		}else if( this->width == 256 ){
+			this->evaluate_parallel< FourValued< Lanes< 4 > > >( input_sets, output_sets );
+		}else{
+			this->evaluate_parallel< FourValued< Lanes< 1 > > >( input_sets, output_sets );
+		}
+	}else if( this->width == 512 ){
+		this->evaluate_parallel< Lanes< 8 > >( input_sets, output_sets );
+	}else if( this->width == 256 ){
+		this->evaluate_parallel< Lanes< 4 > >( input_sets, output_sets );
+	}else{
+		this->evaluate_parallel< Lanes< 1 > >( input_sets, output_sets );
+	}
+}
+
+/** Method reads sets of inputs from the text, evaluates them and writes them with the outputs in the text format.
+	@param begin Beginning of the text.
+	@param end End of the text, it has to end with a complete line.
+	@param fname Name of the source of the text, used in warnings.
+	@param first_line Number of the first line of the text within its source, used in warnings.
+	@param [out] output Text with the sets of inputs and evaluated outputs.
+	@return Method returns number of evaluated sets.
+*/
+size_t Circuit::evaluate_text( const char * begin, const char * end, const std::string & fname, int first_line, std::string & output ){
+	output.clear();
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return 0;
+	}
+	Batch batch;
+	batch.inputs.reset( this->input_columns.size() );
+	batch.outputs.reset( this->output_nodes.size() );
+	Tokenizer tokenizer( begin, end, first_line );
+	size_t count = this->read_sets( tokenizer, fname, batch.inputs, SIZE_MAX );
+	this->evaluate_sets( batch.inputs, batch.outputs );
+	std::ostringstream text;
+	this->write_sets( text, batch.inputs, batch.outputs );
+	output = text.str();
+	return count;
+}
+
+/** Method writes evaluated outputs into file.
+@param fname Name of the file where the output values are supposed to be stored.
+@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::writeOutputs( const std::string & fname ){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	std::ofstream file( fname, this->binary_output ? std::ios::binary : std::ios::out );
+	if( !file ){
+		this->errors.push_back( "error: Couldn't open output file for writing!" );
+		this->_good = false;
+		return false;
+	}
+	if( this->binary_output ){
+		VectorFile::write_header( file, this->output_nodes, this->output_sets.size() );
+		this->write_binary_sets( file, this->output_sets );
+	}else{
+		this->write_sets( file, this->input_sets, this->output_sets );
+	}
+	file.close();
+	return true;
+}
+
+/** Method writes number of toggles and glitches of every node counted by timing simulation into the file, one node per line.
+	@param fname Name of the file where the counts are supposed to be stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::write_toggles( const std::string & fname ){
+	if( this->delays.empty() ){
+		this->errors.push_back( "error: toggles are counted only by timing simulation" );
+		this->_good = false;
+		return false;
+	}
+	std::ofstream file( fname );
+	if( !file ){
+		this->errors.push_back( "error: Couldn't open toggles file for writing!" );
+		this->_good = false;
+		return false;
+	}
+	file<<"node toggles glitches\n";
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		file<<this->netlist.nodes[ node ]<<" "<<this->toggles[ node ]<<" "<<this->glitches[ node ]<<"\n";
+	}
+	file.close();
+	return true;
+}
+
+/** Method writes activity of the nodes counted so far into the file: toggle coverage, a line with number of ones and toggles of every node
+	and list of nodes which never toggled.
+	@param fname Name of the file where the activity is supposed to be stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::write_activity( const std::string & fname ){
+	if( !this->registers.empty() ){
+		this->errors.push_back( "error: activity is counted only for combinational circuits" );
+		this->_good = false;
+		return false;
+	}
+	std::ofstream file( fname );
+	if( !file ){
+		this->errors.push_back( "error: Couldn't open activity file for writing!" );
+		this->_good = false;
+		return false;
+	}
+	this->activity_ones.resize( this->netlist.size() );
+	this->activity_toggles.resize( this->netlist.size() );
+	//Nodes created by the optimizer have no number in the file, they are left out of the report
+	size_t reported = 0;
+	size_t toggled = 0;
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		if( this->netlist.nodes[ node ] >= 0 ){
+			reported++;
+			toggled += this->activity_toggles[ node ] != 0;
+		}
+	}
+	file<<"sets: "<<this->activity_sets<<" nodes: "<<reported<<" toggled: "<<toggled<<" toggle coverage: "<<std::fixed<<std::setprecision( 2 );
+	file<<( reported ? 100.0 * toggled / reported : 100.0 )<<"%\n";
+	file<<"node ones toggles\n";
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		if( this->netlist.nodes[ node ] >= 0 ){
+			file<<this->netlist.nodes[ node ]<<" "<<this->activity_ones[ node ]<<" "<<this->activity_toggles[ node ]<<"\n";
+		}
+	}
+	file<<"never toggled:";
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		if( this->netlist.nodes[ node ] >= 0 && this->activity_toggles[ node ] == 0 ){
+			file<<" "<<this->netlist.nodes[ node ];
+		}
+	}
+	file<<"\n";
+	file.close();
+	return true;
+}
+
+/** Method starts writing values of the nodes evaluated bit-parallel from now on into Value Change Dump file, set i is time i of the dump.
+	Only combinational circuits are traced, the file is written by a separate thread and closed by close_waveform.
+	@param fname Name of the file, name ending with .gz selects file compressed with gzip.
+	@param nodes Numbers of the traced nodes, all nodes are traced if it is empty.
+	@param min_level Minimal level of the traced nodes.
+	@param max_level Maximal level of the traced nodes.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::open_waveform( const std::string & fname, const std::vector< int > & nodes, uint32_t min_level, uint32_t max_level ){
+	if( !this->registers.empty() ){
+		this->errors.push_back( "error: waveform is written only for combinational circuits" );
+		this->_good = false;
+		return false;
+	}
+	//Nodes created by the optimizer have no number in the file, so they are never traced
+	std::unordered_map< int, uint32_t > indices;
+	for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+		if( this->netlist.nodes[ node ] >= 0 ){
+			indices[ this->netlist.nodes[ node ] ] = node;
+		}
+	}
+	std::vector< uint32_t > selected;
+	if( nodes.empty() ){
+		for( uint32_t node = 0; node < this->netlist.size(); node++ ){
+			if( this->netlist.nodes[ node ] >= 0 ){
+				selected.push_back( node );
+			}
+		}
+	}
+	for( int node : nodes ){
+		auto found = indices.find( node );
+		if( found == indices.end() ){
+			this->errors.push_back( "warning: ommiting traced node " + std::to_string( node ) + " - it is not present in the circuit" );
+		}else{
+			selected.push_back( found->second );
+		}
+	}
+	this->traced.clear();
+	std::vector< int > ids;
+	std::vector< uint32_t > levels;
+	for( uint32_t node : selected ){
+		if( this->netlist.levels[ node ] >= min_level && this->netlist.levels[ node ] <= max_level ){
+			this->traced.push_back( node );
+			ids.push_back( this->netlist.nodes[ node ] );
+			levels.push_back( this->netlist.levels[ node ] );
+		}
+	}
+	if( this->traced.empty() ){
+		this->errors.push_back( "error: no nodes of the circuit are selected for the waveform" );
+		this->_good = false;
+		return false;
+	}
+	this->waveform.reset( new WaveformWriter() );
+	std::string error = this->waveform->open( fname, ids, levels );
+	if( error != "" ){
+		this->waveform.reset();
+		this->errors.push_back( error );
+		this->_good = false;
+		return false;
+	}
+	this->traced_sets = 0;
+	return true;
+}
+
+/** Method waits until values of all evaluated sets are written into the waveform file and closes it.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::close_waveform(){
+	if( !this->waveform ){
+		return true;
+	}
+	std::string error = this->waveform->close();
+	this->waveform.reset();
+	if( error != "" ){
+		this->errors.push_back( error );
+		this->_good = false;
+		return false;
+	}
+	return true;
+}
+
+/** Method writes sets of inputs into the file in the packed binary format, values which have not been defined are written as 0.
+	@param fname Name of the file where the inputs are supposed to be stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::writeInputs( const std::string & fname ){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	std::ofstream file( fname, std::ios::binary );
+	if( !file ){
+		this->errors.push_back( "error: Couldn't open file for writing packed inputs!" );
+		this->_good = false;
+		return false;
+	}
+	std::vector< int > nodes;
+	for( const auto & input : this->input_columns ){
+		nodes.push_back( input.first );
+	}
+	VectorFile::write_header( file, nodes, this->input_sets.size() );
+	for( size_t block = 0; block < this->input_sets.blocks(); block++ ){
+		const uint64_t * values = this->input_sets.block_values( block );
+		const uint64_t * defined = this->input_sets.block_defined( block );
+		for( int column = 0; column < this->input_sets.width(); column++ ){
+			uint64_t word = values[ column ] & defined[ column ];
+			file.write( ( const char * )&word, sizeof( word ) );
+		}
+	}
+	file.close();
+	return true;
+}
+
+/** Method writes sets of inputs and evaluated outputs into the stream.
+	@param file Stream the sets are written to.
+	@param input_sets Sets of input data.
+	@param output_sets Sets of evaluated output data.
+*/
+void Circuit::write_sets( std::ostream & file, const VectorSet & input_sets, const VectorSet & output_sets ){
+	//Four-valued sets write every input, undefined values are X or Z
+	auto symbol = []( const VectorSet & sets, size_t set, int column ){
+		bool value = sets.value( set, column );
+		return sets.is_defined( set, column ) ? char( '0' + value ) : value ? 'Z' : 'X';
+	};
+	for( size_t i = 0; i < output_sets.size(); i++ ){
+		file<<"IN: ";
+		for( const auto & input : this->input_columns ){
+			if( this->four_valued ){
+				file<<input.first<<":"<<symbol( input_sets, i, input.second )<<" ";
+			}else if( input_sets.is_defined( i, input.second ) ){
+				file<<input.first<<":"<<input_sets.value( i, input.second )<<" ";
+			}
+		}
+		file<<"OUT: ";
+		for( size_t column = 0; column < this->output_nodes.size(); column++ ){
+			if( this->four_valued ){
+				file<<this->output_nodes[ column ]<<":"<<symbol( output_sets, i, column )<<" ";
+			}else{
+				file<<this->output_nodes[ column ]<<":"<<output_sets.value( i, column )<<" ";
+			}
+		}
+		if( !this->delays.empty() ){
+			file<<"SETTLE: ";
+			for( size_t column = 0; column < this->output_nodes.size(); column++ ){
+				file<<this->output_nodes[ column ]<<":"<<this->settle_times[ i * this->output_nodes.size() + column ]<<" ";
+			}
+			file<<"DEPTH: "<<this->path_depths[i]<<" ";
+		}
+		file<<'\n';
+	}
+}
+
+/** Method writes blocks of evaluated outputs into the stream in the binary format.
+	@param file Stream the sets are written to, it has to be opened in binary mode.
+	@param output_sets Sets of evaluated output data.
+*/
+void Circuit::write_binary_sets( std::ostream & file, const VectorSet & output_sets ){
+	if( output_sets.blocks() ){
+		file.write( ( const char * )output_sets.block_values( 0 ), output_sets.blocks() * output_sets.width() * sizeof( uint64_t ) );
+	}
+}
+
+/** Method reads, evaluates and writes sets of data in batches, so the memory used does not depend on the number of sets.
+	Reading, evaluating and writing run as stages of a pipeline on separate threads, passing batches between each other.
+	@param input_fname Name of the file where the inputs are stored.
+	@param output_fname Name of the file where the output values are supposed to be stored.
+	@param batch_size Number of sets in a single batch.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::simulate( const std::string & input_fname, const std::string & output_fname, size_t batch_size ){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	MappedFile input_file;
+	VectorFile binary_input_file;
+	bool binary_input = VectorFile::is_binary( input_fname );
+	if( binary_input ){
+		std::string error = binary_input_file.open( input_fname );
+		if( error != "" ){
+			this->errors.push_back( error );
+			this->_good = false;
+			return false;
+		}
+	}else{
+		if( !input_file.open( input_fname ) ){
+			this->errors.push_back( "error: Couldn't open inputs file for reading!");
+			this->_good = false;
+			return false;
+		}
+		this->counters.bytes_parsed += input_file.size();
+	}
+
+	//Batches are kept aligned to blocks of 64 sets, so binary blocks are copied and written whole, and hold whole clock cycles of all testbenches
+	size_t alignment = std::lcm( size_t( 64 ), size_t( this->testbenches ) );
+	batch_size = ( batch_size + alignment - 1 ) / alignment * alignment;
+	Tokenizer tokenizer( input_file.data(), input_file.data() + input_file.size() );
+	size_t first = 0;
+	return this->run_pipeline( output_fname, [ & ]( VectorSet & sets ){
+		if( binary_input ){
+			size_t count = std::min( batch_size, binary_input_file.size() - first );
+			if( count == 0 ){
+				return false;
+			}
+			this->read_binary_sets( binary_input_file, input_fname, first, count, sets );
+			first += count;
+			return true;
+		}
+		return this->read_sets( tokenizer, input_fname, sets, batch_size ) != 0;
+	} );
+}
+
+/** Method runs pipeline evaluating batches of sets and writing them to the output file on separate threads.
+	@param output_fname Name of the file where the output values are supposed to be stored.
+	@param read Function filling empty batch of input sets on the reading thread, it returns false when there are no more sets.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::run_pipeline( const std::string & output_fname, const std::function< bool( VectorSet & ) > & read ){
+	std::ofstream output_file( output_fname, this->binary_output ? std::ios::binary : std::ios::out );
+	if( !output_file ){
+		this->errors.push_back( "error: Couldn't open output file for writing!" );
+		this->_good = false;
+		return false;
+	}
+	if( this->binary_output ){
+		VectorFile::write_header( output_file, this->output_nodes, 0 );
+	}
+
+	//Fixed number of batches circulates between the stages, which bounds the memory used
+	const size_t batch_count = 4;
+	std::vector< Batch > batches( batch_count );
+	Channel< Batch * > free_batches( batch_count );
+	Channel< Batch * > read_batches( batch_count );
+	Channel< Batch * > evaluated_batches( batch_count );
+	for( auto & batch : batches ){
+		free_batches.push( &batch );
+	}
+
+	std::thread reader( [ & ](){
+		Batch * batch;
+		while( free_batches.pop( batch ) ){
+			batch->inputs.reset( this->input_columns.size() );
+			if( !read( batch->inputs ) ){
+				break;
+			}
+			read_batches.push( batch );
+		}
+		read_batches.close();
+	} );
+	uint64_t written = 0;
+	std::thread writer( [ & ](){
+		Batch * batch;
+		while( evaluated_batches.pop( batch ) ){
+			if( this->binary_output ){
+				this->write_binary_sets( output_file, batch->outputs );
+			}else{
+				this->write_sets( output_file, batch->inputs, batch->outputs );
+			}
+			written += batch->outputs.size();
+			free_batches.push( batch );
+		}
+		free_batches.close();
+	} );
+
+	Batch * batch;
+	while( read_batches.pop( batch ) ){
+		batch->outputs.reset( this->output_nodes.size() );
+		this->evaluate_sets( batch->inputs, batch->outputs );
+		evaluated_batches.push( batch );
+	}
+	evaluated_batches.close();
+	reader.join();
+	writer.join();
+	if( this->binary_output ){
+		VectorFile::update_count( output_file, written );
+	}
+	return true;
+}
+
+/** Method fills sets with consecutive assignments of the inputs, bit i of the number of the set is the value of input column i.
+	@param first Number of the first set, it has to be a multiple of 64.
+	@param count Number of sets.
+	@param [out] sets Filled sets, their previous content is replaced.
+*/
+void Circuit::enumerate_sets( uint64_t first, size_t count, VectorSet & sets ){
+	//Lowest six columns repeat the same pattern in every block, higher columns are constant within a block
+	static const uint64_t patterns[ 6 ] = { 0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull, 0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull };
+	sets.reset( this->input_columns.size() );
+	sets.resize( count );
+	for( size_t block = 0; block < sets.blocks(); block++ ){
+		uint64_t * values = sets.block_values( block );
+		uint64_t * defined = sets.block_defined( block );
+		uint64_t number = first / 64 + block;
+		for( int column = 0; column < sets.width(); column++ ){
+			values[ column ] = column < 6 ? patterns[ column ] : ( number >> ( column - 6 ) ) & 1 ? ~uint64_t( 0 ) : 0;
+			defined[ column ] = ~uint64_t( 0 );
+		}
+	}
+}
+
+/**
+	@return Method returns true if the inputs are few enough to be enumerated, otherwise returns false and sets error message.
+*/
+bool Circuit::check_enumerable(){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	if( this->input_columns.size() >= 64 ){
+		this->errors.push_back( "error: too many inputs to enumerate: " + std::to_string( this->input_columns.size() ) );
+		this->_good = false;
+		return false;
+	}
+	if( !this->registers.empty() ){
+		this->errors.push_back( "error: sequential circuit can't be enumerated, its outputs depend on previous sets" );
+		this->_good = false;
+		return false;
+	}
+	return true;
+}
+
+/** Method evaluates every assignment of the inputs and writes the truth table, assignments are generated internally in batches.
+	@param output_fname Name of the file where the truth table is supposed to be stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::enumerate( const std::string & output_fname ){
+	if( !this->check_enumerable() ){
+		return false;
+	}
+	uint64_t total = uint64_t( 1 ) << this->input_columns.size();
+	uint64_t first = 0;
+	return this->run_pipeline( output_fname, [ & ]( VectorSet & sets ){
+		if( first == total ){
+			return false;
+		}
+		size_t count = std::min( total - first, enumeration_batch );
+		this->enumerate_sets( first, count, sets );
+		first += count;
+		return true;
+	} );
+}
+
+/** Method compares outputs of two circuits for every assignment of the inputs.
+	Both circuits have to have the same input and output nodes, evaluation stops at the first mismatch.
+	@param other Circuit compared with this one.
+	@param [out] result Description of the result: confirmation of equivalence or the first mismatching set.
+	@return Method returns true if the comparison has been done, otherwise returns false and sets error message.
+*/
+bool Circuit::check_equivalence( Circuit & other, std::string & result ){
+	if( !this->check_enumerable() || !other.built ){
+		return false;
+	}
+	std::vector< int > input_nodes, other_input_nodes;
+	for( const auto & input : this->input_columns ){
+		input_nodes.push_back( input.first );
+	}
+	for( const auto & input : other.input_columns ){
+		other_input_nodes.push_back( input.first );
+	}
+	if( !other.registers.empty() ){
+		this->errors.push_back( "error: sequential circuit can't be enumerated, its outputs depend on previous sets" );
+		this->_good = false;
+		return false;
+	}
+	if( input_nodes != other_input_nodes || this->output_nodes != other.output_nodes ){
+		this->errors.push_back( "error: compared circuits have different input or output nodes" );
+		this->_good = false;
+		return false;
+	}
+
+	uint64_t total = uint64_t( 1 ) << input_nodes.size();
+	VectorSet inputs, outputs, other_outputs;
+	for( uint64_t first = 0; first < total; first += enumeration_batch ){
+		size_t count = std::min( total - first, enumeration_batch );
+		this->enumerate_sets( first, count, inputs );
+		outputs.reset( this->output_nodes.size() );
+		other_outputs.reset( this->output_nodes.size() );
+		this->evaluate_sets( inputs, outputs );
+		other.evaluate_sets( inputs, other_outputs );
+		for( size_t block = 0; block < outputs.blocks(); block++ ){
+			const uint64_t * values = outputs.block_values( block );
+			const uint64_t * other_values = other_outputs.block_values( block );
+			uint64_t mask = block + 1 < outputs.blocks() || count % 64 == 0 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( count % 64 ) ) - 1;
+			uint64_t difference = 0;
+			for( int column = 0; column < outputs.width(); column++ ){
+				difference |= ( values[ column ] ^ other_values[ column ] ) & mask;
+			}
+			if( difference == 0 ){
+				continue;
+			}
+			//Lowest differing bit is the first mismatching set of the block
+			size_t set = block * 64 + __builtin_ctzll( difference );
+			result = "circuits differ, first mismatching set: IN: ";
+			for( size_t column = 0; column < input_nodes.size(); column++ ){
+				result += std::to_string( input_nodes[ column ] ) + ":" + std::to_string( inputs.value( set, column ) ) + " ";
+			}
+			result += "OUT: ";
+			for( size_t column = 0; column < this->output_nodes.size(); column++ ){
+				bool value = outputs.value( set, column );
+				bool other_value = other_outputs.value( set, column );
+				result += std::to_string( this->output_nodes[ column ] ) + ":" + std::to_string( value );
+				result += value != other_value ? "/" + std::to_string( other_value ) + " " : " ";
+			}
+			return true;
+		}
+	}
+	result = "circuits are equivalent for all " + std::to_string( total ) + " sets of inputs";
+	return true;
+}
+
+/** Method grades the read sets of inputs by stuck-at-0 and stuck-at-1 faults of every gate output and writes the report.
+	Report starts with the fault coverage, followed by a line for every fault with the first set detecting it in order of node numbers, sets are numbered from 1 in order of reading.
+	Gates of the circuit file which drive no output are graded too, their faults are never detected.
+	Only combinational circuits are graded, values which have not been defined are 0.
+	@param fname Name of the file where the report is supposed to be stored.
+	@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+*/
+bool Circuit::grade_faults( const std::string & fname ){
+	if( !this->built ){
+		this->errors.push_back( "error: Circuit not built" );
+		this->_good = false;
+		return false;
+	}
+	if( !this->registers.empty() ){
+		this->errors.push_back( "error: sequential circuit can't be graded by stuck-at faults, its outputs depend on previous sets" );
+		this->_good = false;
+		return false;
+	}
+	std::vector< Fault > faults;
+	for( uint32_t node = this->netlist.input_count; node < this->netlist.size(); node++ ){
+		faults.push_back( { node, false, UINT64_MAX } );
+		faults.push_back( { node, true, UINT64_MAX } );
+	}
+	size_t fault_count = faults.size() + this->unconnected.size() * 2;
+	this->counters.vectors += this->input_sets.size();
+	if( this->width == 512 ){
+		this->simulate_faults< Lanes< 8 > >( this->input_sets, faults );
+	}else if( this->width == 256 ){
+		this->simulate_faults< Lanes< 4 > >( this->input_sets, faults );
+	}else{
+		this->simulate_faults< Lanes< 1 > >( this->input_sets, faults );
+	}
+
+	std::ofstream file( fname );
+	if( !file ){
+		this->errors.push_back( "error: Couldn't open output file for writing!" );
+		this->_good = false;
+		return false;
+	}
+	size_t detected = std::count_if( faults.begin(), faults.end(), []( const Fault & fault ){
+		return fault.detected != UINT64_MAX;
+	} );
+	file<<"faults: "<<fault_count<<" detected: "<<detected<<" coverage: "<<std::fixed<<std::setprecision( 2 );
+	file<<( fault_count ? 100.0 * detected / fault_count : 100.0 )<<"%\n";
+
+	//Faults are listed by node numbers, gates driving no output can't be detected by any set
+	std::vector< std::pair< int, uint64_t > > listed;
+	for( size_t i = 0; i < faults.size(); i += 2 ){
+		listed.push_back( { this->netlist.nodes[ faults[i].node ], i } );
+	}
+	for( int node : this->unconnected ){
+		listed.push_back( { node, UINT64_MAX } );
+	}
+	std::sort( listed.begin(), listed.end() );
+	for( const auto & entry : listed ){
+		for( int value = 0; value < 2; value++ ){
+			uint64_t set = entry.second == UINT64_MAX ? UINT64_MAX : faults[ entry.second + value ].detected;
+			file<<entry.first<<" stuck-at-"<<value;
+			if( set == UINT64_MAX ){
+				file<<" undetected\n";
+			}else{
+				file<<" detected by set "<<set + 1<<"\n";
+			}
+		}
+	}
+	file.close();
+	return true;
+}
+
+/**
+	@return Function returns vector containing descriptions of encountered errors.
+*/
+std::vector<std::string> Circuit::get_errors(){
+	return this->errors;
+}
+
+/**
+	@return Function returns last encountered error.
+*/
+std::string Circuit::get_last_error(){
+	return this->errors[ this->errors.size() - 1 ];
+}
+
+/**
+	@return Function returns number of gates in the built circuit.
+*/
+size_t Circuit::gate_count(){
+	return this->netlist.size() - this->netlist.input_count;
+}
+
+/**
+	@return Function returns number of input vectors read.
+*/
+size_t Circuit::vector_count(){
+	return this->input_sets.size();
+}
+
+/**
+	@return Function returns counters of the work done by the circuit.
+*/
+const Counters & Circuit::get_counters(){
+	return this->counters;
+}
+
+/**
+	@return Function returns levelized netlist of the built circuit.
+*/
+const Netlist & Circuit::get_netlist(){
+	return this->netlist;
 }
 
 /**
@@ -9,12 +9,23 @@
 #define CIRCUIT_H
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <vector>
 
+#include "channel.h"
 #include "gate.h"
+#include "lanes.h"
+#include "native.h"
+#include "netlist.h"
+#include "stats.h"
+#include "thread_pool.h"
+#include "tokenizer.h"
+#include "vector_file.h"
+#include "vector_set.h"
+#include "waveform.h"
 
 /**
 Class representing simulated circuit
@@ -23,14 +34,289 @@ reading input values from the inputs file and elaborating and writing output val
  */
 class Circuit
 {	
-	std::map< int, std::shared_ptr< Gate > > gates;   	//**<Map connecting nubers of output nodes of gates to instances representing those gates
-	std::map< int, std::shared_ptr< Gate > > inputs;	//**<Map connecting nubers of input nodes to instances representing those inputs
-	std::vector< std::shared_ptr< Gate > > outputs; 	//**<Vector containing pointers to instances of output nodes
-	std::vector< std::map< int, bool > > output_sets;	//**<Vector containing sets of input data stored as maps connecting numbers of input nodes to their value
-	std::vector< std::map< int, bool > > input_sets;	//**<Vector containing sets of elaborated output data stored as maps connecting numbers of output nodes to their value
+	/**
+	Structure holding batch of sets passed between stages of the simulation pipeline.
+	*/
+	struct Batch{
+		VectorSet inputs;/**< Sets of input data*/
+		VectorSet outputs;/**< Sets of evaluated output data*/
+	};
+
+	/**
+	Structure holding instance of a module.
+	*/
+	struct Instance{
+		size_t module;/**< Index of the instantiated module*/
+		std::vector< int > ports;/**< Nodes connected to the inputs and then to the outputs of the module*/
+	};
+
+	/**
+	Structure holding definition of a module, its nodes are numbered locally.
+	*/
+	struct Module{
+		std::string name;/**< Name of the module*/
+		std::vector< int > inputs;/**< Local numbers of the input ports*/
+		std::vector< int > outputs;/**< Local numbers of the output ports, each of them has to be driven inside the module*/
+		std::vector< Gate > gates;/**< Gates of the module*/
+		std::vector< Instance > instances;/**< Instances of modules defined before this one*/
+		uint64_t node_count;/**< Number of nodes created by every instance of the module, apart from its ports*/
+	};
+
+	/**
+	Structure holding stuck-at fault of a gate output.
+	*/
+	struct Fault{
+		uint32_t node;/**< Index of the faulty node*/
+		bool value;/**< Value the node is stuck at*/
+		uint64_t detected;/**< Number of the first set detecting the fault, UINT64_MAX if no set detects it*/
+	};
+
+	/**
+	Structure holding cluster of outputs evaluated by one thread when there are too few sets to keep all threads busy.
+	*/
+	struct Cluster{
+		std::vector< uint32_t > nodes;/**< Indices of the gates in input cones of the outputs, in topological order*/
+		std::vector< size_t > columns;/**< Output columns of the cluster*/
+	};
+
+
+	Arena arena;										//**<Arena owning all gates of the built circuit, released at once after compilation
+	std::map< int, Gate * > gates;   					//**<Map connecting nubers of output nodes of gates to instances representing those gates
+	std::map< int, Gate * > inputs;						//**<Map connecting nubers of input nodes to instances representing those inputs, released after compilation
+	std::vector< Gate * > outputs; 						//**<Vector containing pointers to instances of output nodes, released after compilation
+	std::vector< Module > modules;						//**<Modules defined in the circuit file, released after compilation
+	std::map< std::string, size_t, std::less<> > module_indices;	//**<Map connecting names of modules to their indices
+	std::vector< Instance > instances;					//**<Instances of modules in the top level of the circuit
+	VectorSet output_sets;								//**<Sets of elaborated output data, columns are output nodes in ascending order
+	VectorSet input_sets;								//**<Sets of input data, columns are input nodes in ascending order
+	Netlist netlist;									//**<Levelized circuit stored as contiguous arrays indexed by dense node indices
+	std::map< int, int > input_columns;					//**<Map connecting numbers of input nodes to columns of sets of input data
+	std::vector< int > input_indices;					//**<Vector containing indices of values of the input columns, -1 if the input drives no output
+	std::vector< int > output_nodes;					//**<Vector containing numbers of output nodes in ascending order
+	std::vector< int > output_indices;					//**<Vector containing indices of values of the output columns
+	std::vector< int > unconnected;						//**<Numbers of gates of the circuit file which drive no output and are left out of the netlist, in ascending order
+	int width;											//**<Number of input vectors simulated in parallel
+	std::unique_ptr< ThreadPool > pool;					//**<Pool of threads evaluating sets of input data
+	bool binary_output;									//**<Flag set if outputs are written in the packed binary format
+	NativeNetlist native;								//**<Netlist compiled to native code, used by bit-parallel evaluation if loaded
+	bool event_driven;									//**<Flag set if sets are evaluated event driven instead of bit-parallel
+	std::vector< uint8_t > state;						//**<Values of all nodes for the last set evaluated event driven, 0 or 0xFF
+	std::vector< bool > scheduled;						//**<Flags set for nodes waiting for evaluation in event driven mode
+	std::vector< std::vector< uint32_t > > events;		//**<Nodes waiting for evaluation in event driven mode, grouped by level
+	int testbenches;									//**<Number of independent testbenches of sequential circuit, consecutive sets are their consecutive clock cycles
+	std::vector< uint32_t > registers;					//**<Indices of flip-flops and latches, whose values are kept between clock cycles
+	std::vector< uint64_t > register_state;				//**<Packed values and flags of definition of the registers between batches, indexed by block of 64 testbenches and then by register
+	bool four_valued;									//**<Flag set if values 0, 1, X and Z are simulated, undefined inputs and initial values of registers are X
+	std::vector< uint32_t > delays;						//**<Delay of every node in timing simulation, empty if sets are evaluated without delays
+	std::vector< uint64_t > settle_times;				//**<Time of the last change of every output in every set of the last timing simulation, indexed by set and then by output column
+	std::vector< uint32_t > path_depths;				//**<Number of gates on the longest chain of changes reaching an output in every set of the last timing simulation
+	std::vector< uint64_t > toggles;					//**<Number of changes of every node in timing simulation
+	std::vector< uint64_t > glitches;					//**<Number of pulses of every node in timing simulation, pairs of changes cancelling each other within a set
+	bool activity;										//**<Flag set if activity of the nodes is counted by bit-parallel evaluation
+	uint64_t activity_sets;								//**<Number of sets the activity has been counted for
+	std::vector< uint64_t > activity_ones;				//**<Number of sets where every node was 1
+	std::vector< uint64_t > activity_toggles;			//**<Number of changes of every node between consecutive sets
+	VectorSet activity_last;							//**<Last set the activity has been counted for, its change to the next evaluated set is counted too
+	std::unique_ptr< WaveformWriter > waveform;			//**<Writer of values of the traced nodes, NULL if the nodes are not traced
+	std::vector< uint32_t > traced;						//**<Indices of the nodes written into the waveform
+	uint64_t traced_sets;								//**<Number of sets written into the waveform so far
+	std::vector< Cluster > clusters;					//**<Clusters of outputs with mostly disjoint input cones, empty until they are needed
+	Counters counters;									//**<Counters of the work done by the circuit
 	std::vector< std::string > errors;					//**<Vector containing error messages
 	bool _good;											//**<Flag set if there are no problems with the circuit
 	bool built;											//**<Flag set if the circuit has been built succesfully
+
+	/** Method reads line of the circuit file defining or instantiating a module.
+		@param keyword First token of the line: MODULE, END or INST.
+		@param tokenizer Tokenizer of the circuit file, positioned after the keyword.
+		@param fname Name of the file where the circuit structure is stored, used in error messages.
+		@param [in,out] module Index of the module being defined, SIZE_MAX outside of modules.
+	*/
+	void read_module_line( std::string_view keyword, Tokenizer & tokenizer, const std::string & fname, size_t & module );
+
+	/** Method checks that every node of the finished module is driven and counts the nodes created by its instances.
+		@param module Defined module.
+		@param fname Name of the file where the circuit structure is stored, used in error messages.
+		@param line Number of the line ending the module.
+		@return Method returns false if the module is incorrect.
+	*/
+	bool finish_module( Module & module, const std::string & fname, int line );
+
+	/** Method creates gates of the module instance, internal nodes of the module get fresh numbers.
+		@param module Instantiated module.
+		@param ports Nodes connected to the inputs and then to the outputs of the module.
+		@param [in,out] next Next free number of node.
+	*/
+	void instantiate( const Module & module, const std::vector< int > & ports, int & next );
+
+	/** Method levelizes built circuit into netlist with nodes renumbered in topological order.
+		Only gates driving the output nodes are compiled.
+		@param fname Name of the file where the circuit structure is stored, used in error messages.
+		@return Method returns true if the circuit has been compiled succesfully, otherwise returns false and sets an error message.
+	*/
+	bool compile( const std::string & fname );
+
+	/** Method collects flip-flops and latches of the netlist and clears their values. */
+	void find_registers();
+
+	/** Method loads circuit compiled before from the binary snapshot, without parsing and levelizing it.
+		@param fname Name of the snapshot file.
+		@return Method returns true if the circuit has been loaded succesfully, otherwise returns false and sets an error message.
+	*/
+	bool load( const std::string & fname );
+
+	/** Method reads sets of inputs from the text and appends them to the given set.
+		@param tokenizer Tokenizer of the text the inputs are read from.
+		@param fname Name of the file where the inputs are stored, used in warnings.
+		@param [in,out] sets Sets of input data the read sets are appended to.
+		@param limit Maximal number of sets to be read.
+		@return Method returns number of read sets.
+	*/
+	size_t read_sets( Tokenizer & tokenizer, const std::string & fname, VectorSet & sets, size_t limit );
+
+	/** Method copies sets of inputs from the binary file and appends them to the given set.
+		@param file Mapped binary file with sets of inputs.
+		@param fname Name of the file where the inputs are stored, used in warnings.
+		@param first Index of the first set to be copied, it has to be a multiple of 64.
+		@param count Number of sets to be copied.
+		@param [in,out] sets Sets of input data the copied sets are appended to.
+	*/
+	void read_binary_sets( const VectorFile & file, const std::string & fname, size_t first, size_t count, VectorSet & sets );
+
+	/** Method evaluates output values for given sets of input data, packing Word::size * 64 sets into every bit-parallel word.
+		Groups of sets are distributed between threads of the pool, each group writes its own blocks of outputs so their order does not depend on scheduling.
+		@param input_sets Sets of input data.
+		@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+	*/
+	template< typename Word >
+	void evaluate_lanes( const VectorSet & input_sets, VectorSet & output_sets );
+
+	/** Method loads Word::size blocks of sets into values of the input nodes, blocks past the end are left empty.
+		@param input_sets Sets of input data.
+		@param first Index of the first loaded block.
+		@param [out] values Values of all nodes.
+	*/
+	template< typename Word >
+	void load_inputs( const VectorSet & input_sets, size_t first, std::vector< Word > & values );
+
+	/** Method evaluates every gate of the netlist once, by the native code if it is loaded and evaluates two-valued logic.
+		@param [in,out] values Values of all nodes, values of the input nodes and registers have to be set.
+	*/
+	template< typename Word >
+	void sweep( std::vector< Word > & values );
+
+	/** Method evaluates gates of the cluster once.
+		@param [in,out] values Values of all nodes, values of the input nodes have to be set.
+		@param nodes Indices of the evaluated gates, in topological order.
+	*/
+	template< typename Word >
+	void sweep_cluster( std::vector< Word > & values, const std::vector< uint32_t > & nodes );
+
+	/** Method partitions outputs into balanced clusters with mostly disjoint input cones, one cluster per thread of the pool at most.
+		Outputs are taken from the biggest cone and every one goes to the cluster which is the smallest after adding gates of its cone missing in the cluster.
+	*/
+	void partition_outputs();
+
+	/**
+		@return Method returns for every output column the input column read by it directly, -1 for outputs driven by gates.
+	*/
+	std::vector< int > direct_inputs();
+
+	/** Method counts ones and changes between consecutive sets of every node within a group of sets evaluated together.
+		@param values Values of all nodes for the group.
+		@param first Index of the first block of the group.
+		@param count Number of all evaluated sets.
+		@param [in,out] ones Number of sets where every node was 1.
+		@param [in,out] toggles Number of changes of every node between consecutive sets.
+	*/
+	template< typename Word >
+	void count_activity( const std::vector< Word > & values, size_t first, size_t count, std::vector< uint64_t > & ones, std::vector< uint64_t > & toggles );
+
+	/** Method counts changes of every node between consecutive sets evaluated in different groups, or in the previous call.
+		Last and first sets of neighbouring groups are packed into two sets of their own and evaluated again, so the groups need not be evaluated in order.
+		@param input_sets Sets of input data.
+	*/
+	template< typename Word >
+	void count_boundaries( const VectorSet & input_sets );
+
+	/** Method evaluates sequential circuit, set i is clock cycle i / testbenches of testbench i % testbenches.
+		Every lane of the bit-parallel words simulates its own testbench, groups of Word::size * 64 testbenches are distributed between threads of the pool.
+		Combinational logic is evaluated once per cycle, then flip-flops take values of their inputs. Values of the registers are kept for the next call.
+		@param input_sets Sets of input data.
+		@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+	*/
+	template< typename Word >
+	void evaluate_cycles( const VectorSet & input_sets, VectorSet & output_sets );
+
+	/** Method evaluates sets bit-parallel with the word type, sequential circuits clock by clock.
+		@param input_sets Sets of input data.
+		@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+	*/
+	template< typename Word >
+	void evaluate_parallel( const VectorSet & input_sets, VectorSet & output_sets );
+
+	/** Method evaluates output values for given sets of input data one by one, keeping values of all nodes between the sets.
+		Only fanouts of nodes whose value has changed are evaluated, in order of their levels, and propagation stops at gates whose value stays the same.
+		Every set is a clock cycle of a single testbench, flip-flops take values of their inputs after it.
+		@param input_sets Sets of input data.
+		@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+	*/
+	void evaluate_events( const VectorSet & input_sets, VectorSet & output_sets );
+
+	/** Method evaluates sets one by one with delays of the gates, keeping values of all nodes between the sets.
+		The first set starts settled, inputs and flip-flops change at time 0 of every later set, gate evaluated at time t after change of its input changes its output at time t + its delay.
+		Changes are kept in a timing wheel and every set lasts until no change is waiting, settle times, path depths, toggles and glitches are recorded.
+		@param input_sets Sets of input data.
+		@param [out] output_sets Sets of evaluated output data, resized to match the inputs.
+	*/
+	void evaluate_timing( const VectorSet & input_sets, VectorSet & output_sets );
+
+	/** Method finds the first set detecting every fault by parallel-pattern single-fault propagation.
+		Good values of Word::size * 64 sets are evaluated by one sweep, then every fault not detected by earlier sets is injected and propagated
+		only through gates whose values differ from the good ones. Detected faults are dropped, remaining faults are partitioned between threads of the pool.
+		@param input_sets Sets of input data.
+		@param [in,out] faults Faults of the circuit, detecting sets are filled in.
+	*/
+	template< typename Word >
+	void simulate_faults( const VectorSet & input_sets, std::vector< Fault > & faults );
+
+	/** Method evaluates output values for given sets of input data using configured number of parallel vectors.
+		@param input_sets Sets of input data.
+		@param [out] output_sets Sets of evaluated output data.
+	*/
+	void evaluate_sets( const VectorSet & input_sets, VectorSet & output_sets );
+
+	/** Method writes sets of inputs and evaluated outputs into the stream.
+		@param file Stream the sets are written to.
+		@param input_sets Sets of input data.
+		@param output_sets Sets of evaluated output data.
+	*/
+	void write_sets( std::ostream & file, const VectorSet & input_sets, const VectorSet & output_sets );
+
+	/** Method runs pipeline evaluating batches of sets and writing them to the output file on separate threads.
+		@param output_fname Name of the file where the output values are supposed to be stored.
+		@param read Function filling empty batch of input sets on the reading thread, it returns false when there are no more sets.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool run_pipeline( const std::string & output_fname, const std::function< bool( VectorSet & ) > & read );
+
+	/** Method fills sets with consecutive assignments of the inputs, bit i of the number of the set is the value of input column i.
+		@param first Number of the first set, it has to be a multiple of 64.
+		@param count Number of sets.
+		@param [out] sets Filled sets, their previous content is replaced.
+	*/
+	void enumerate_sets( uint64_t first, size_t count, VectorSet & sets );
+
+	/**
+		@return Method returns true if the inputs are few enough to be enumerated, otherwise returns false and sets error message.
+	*/
+	bool check_enumerable();
+
+	/** Method writes blocks of evaluated outputs into the stream in the binary format.
+		@param file Stream the sets are written to, it has to be opened in binary mode.
+		@param output_sets Sets of evaluated output data.
+	*/
+	void write_binary_sets( std::ostream & file, const VectorSet & output_sets );
 	
 public:
 	/**
@@ -38,13 +324,97 @@ public:
 	*/
 	Circuit();
 
+	/** Method sets number of input vectors simulated in parallel by every sweep over the circuit.
+		@param width Number of vectors, 64, 256 or 512.
+		@return Method returns true if the number is supported, otherwise returns false and sets an error message.
+	*/
+	bool set_width( int width );
+
+	/** Method sets number of threads evaluating sets of input data.
+		@param threads Number of threads, at least 1.
+		@return Method returns true if the number is correct, otherwise returns false and sets an error message.
+	*/
+	bool set_threads( int threads );
+
+	/** Method selects format of the output file.
+		@param binary True if outputs are written in the packed binary format, false if they are written as text.
+	*/
+	void set_binary_output( bool binary );
+
+	/** Method selects event driven evaluation, which evaluates only gates affected by inputs changed since the previous set.
+		@param event_driven True if sets are evaluated event driven, false if they are evaluated bit-parallel.
+	*/
+	void set_event_driven( bool event_driven );
+
+	/** Method sets number of independent testbenches simulated in parallel by sequential circuits.
+		@param testbenches Number of testbenches, at least 1.
+		@return Method returns true if the number is correct, otherwise returns false and sets an error message.
+	*/
+	bool set_testbenches( int testbenches );
+
+	/** Method selects counting of activity of every node by bit-parallel evaluation of combinational circuits:
+		number of sets where it is 1 and number of its changes between consecutive sets, counted with population count of the packed values.
+		@param activity True if the activity is counted.
+	*/
+	void set_activity( bool activity );
+
+	/** Method selects four-valued simulation, which propagates unknown X and high impedance Z through the gates.
+		Inputs missing in a set or given as X are unknown, flip-flops and latches start unknown. It is evaluated bit-parallel on two bit-planes, without native code.
+		@param four_valued True if values 0, 1, X and Z are simulated, false if only 0 and 1 are.
+	*/
+	void set_four_valued( bool four_valued );
+
+	/** Method sets all flip-flops and latches to their initial value, so the next set starts the first clock cycle again. */
+	void reset_registers();
+
 	/** Method builds a circuit structure according to the circuit file.
+		Files starting with the magic of the snapshot format are loaded instead of being parsed.
+		Gates list their input nodes followed by the output node: AND, NAND, OR, NOR, XOR and XNOR take two or more inputs,
+		"MUX <select> <input0> <input1> <output>" passes input1 when select is 1, "LUT <table> <inputs> <output>" takes 2 to 6 inputs
+		and truth table given in decimal or hexadecimal with 0x prefix, bit i of the table is the output when every input j has value of bit j of i.
+		"DFF <input> <output>" is flip-flop clocked between sets, "LATCH <enable> <input> <output>" passes its input while enable is 1,
+		both start at 0, or at X in four-valued simulation, and loops through flip-flops are allowed.
+		Lines between "MODULE <name>" and "END" define a module with its own IN: and OUT: ports and local node numbers,
+		"INST <name> <input nodes> <output nodes>" places copy of a module defined before, its internal nodes are numbered above all nodes of the file.
 		@return Method returns true if circuit has been built succesfully, otherwise returns false and sets an error message.
 		@param fname Name of the file where the circuit structure is stored.
 	*/ 
 	int build( const std::string & fname );
 
+	/** Method writes the built circuit into binary snapshot, which is loaded by build without parsing.
+		@param fname Name of the snapshot file.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool save( const std::string & fname );
+
+	/** Method keeps only the given outputs of the built circuit, removing gates outside of their input cones. Input nodes are kept.
+		@param nodes Numbers of the kept output nodes, those which are not outputs of the circuit are reported and skipped.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool select_outputs( const std::vector< int > & nodes );
+
+	/** Method removes redundant logic from the built circuit: gates driving no output, structurally identical gates,
+		gates with constant, equal or complementary inputs and chains of negations.
+		@return Method returns true if the circuit has been optimized.
+	*/
+	bool optimize();
+
+	/** Method compiles the built circuit to native code for the configured number of parallel vectors, evaluation then goes through the compiled code.
+		If the compilation fails, a warning is reported and the circuit keeps being evaluated by the interpreter.
+		@return Method returns true if the native code has been loaded.
+	*/
+	bool compile_native();
+
+	/** Method reads delays of the gates and selects timing simulation, which evaluates sets one by one and changes gates their delay after their inputs.
+		Lines "<gate name> <delay>" set delay of every gate of the type, lines "<node> <delay>" set delay of the gate driving the node and take precedence,
+		other gates have delay 1. Delays are whole time units from 1 to 65535. It has to be called after the circuit is built and optimized.
+		@param fname Name of the file where the delays are stored.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool read_delays( const std::string & fname );
+
 	/** Method reads sets of inputs from the file and puts them into object's internal vector.
+		Files starting with the magic of the binary format are mapped into memory instead of being parsed.
 		@param fname Name of the file where the inputs are stored.
 		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
 	*/
@@ -55,12 +425,108 @@ public:
 	*/
 	bool evaluate();
 
+	/** Method reads sets of inputs from the text, evaluates them and writes them with the outputs in the text format.
+		@param begin Beginning of the text.
+		@param end End of the text, it has to end with a complete line.
+		@param fname Name of the source of the text, used in warnings.
+		@param first_line Number of the first line of the text within its source, used in warnings.
+		@param [out] output Text with the sets of inputs and evaluated outputs.
+		@return Method returns number of evaluated sets.
+	*/
+	size_t evaluate_text( const char * begin, const char * end, const std::string & fname, int first_line, std::string & output );
+
 	/** Method writes evaluated outputs into file.
 		@param fname Name of the file where the output values are supposed to be stored.
 		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
 	*/
 	bool writeOutputs( const std::string & fname );
 
+	/** Method writes number of toggles and glitches of every node counted by timing simulation into the file, one node per line.
+		@param fname Name of the file where the counts are supposed to be stored.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool write_toggles( const std::string & fname );
+
+	/** Method writes activity of the nodes counted so far into the file: toggle coverage, a line with number of ones and toggles of every node
+		and list of nodes which never toggled.
+		@param fname Name of the file where the activity is supposed to be stored.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool write_activity( const std::string & fname );
+
+	/** Method starts writing values of the nodes evaluated bit-parallel from now on into Value Change Dump file, set i is time i of the dump.
+		Only combinational circuits are traced, the file is written by a separate thread and closed by close_waveform.
+		@param fname Name of the file, name ending with .gz selects file compressed with gzip.
+		@param nodes Numbers of the traced nodes, all nodes of the file are traced if it is empty.
+		@param min_level Minimal level of the traced nodes.
+		@param max_level Maximal level of the traced nodes.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool open_waveform( const std::string & fname, const std::vector< int > & nodes, uint32_t min_level, uint32_t max_level );
+
+	/** Method waits until values of all evaluated sets are written into the waveform file and closes it.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool close_waveform();
+
+	/** Method writes sets of inputs into the file in the packed binary format, values which have not been defined are written as 0.
+		@param fname Name of the file where the inputs are supposed to be stored.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool writeInputs( const std::string & fname );
+
+	/** Method reads, evaluates and writes sets of data in batches, so the memory used does not depend on the number of sets.
+		Reading, evaluating and writing run as stages of a pipeline on separate threads, passing batches between each other.
+		@param input_fname Name of the file where the inputs are stored.
+		@param output_fname Name of the file where the output values are supposed to be stored.
+		@param batch_size Number of sets in a single batch.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool simulate( const std::string & input_fname, const std::string & output_fname, size_t batch_size );
+
+	/** Method evaluates every assignment of the inputs and writes the truth table, assignments are generated internally in batches.
+		@param output_fname Name of the file where the truth table is supposed to be stored.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool enumerate( const std::string & output_fname );
+
+	/** Method compares outputs of two circuits for every assignment of the inputs.
+		Both circuits have to have the same input and output nodes, evaluation stops at the first mismatch.
+		@param other Circuit compared with this one.
+		@param [out] result Description of the result: confirmation of equivalence or the first mismatching set.
+		@return Method returns true if the comparison has been done, otherwise returns false and sets error message.
+	*/
+	bool check_equivalence( Circuit & other, std::string & result );
+
+	/** Method grades the read sets of inputs by stuck-at-0 and stuck-at-1 faults of every gate output and writes the report.
+		Report starts with the fault coverage, followed by a line for every fault with the first set detecting it in order of node numbers, sets are numbered from 1 in order of reading.
+		Gates of the circuit file which drive no output are graded too, their faults are never detected.
+		Only combinational circuits are graded, values which have not been defined are 0.
+		@param fname Name of the file where the report is supposed to be stored.
+		@return Method returns true if the operation succeded, otherwise returns false and sets error message.
+	*/
+	bool grade_faults( const std::string & fname );
+
+	/**
+		@return Function returns number of gates in the built circuit.
+	*/
+	size_t gate_count();
+
+	/**
+		@return Function returns number of input vectors read.
+	*/
+	size_t vector_count();
+
+	/**
+		@return Function returns counters of the work done by the circuit.
+	*/
+	const Counters & get_counters();
+
+	/**
+		@return Function returns levelized netlist of the built circuit.
+	*/
+	const Netlist & get_netlist();
+
 	/**
 		@return Function returns status of the circuit.
 	*/
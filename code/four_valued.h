@@ -0,0 +1,88 @@
+/**
+ * @file four_valued.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of the word type used for simulation with values 0, 1, X and Z.
+ */
+
+#ifndef FOUR_VALUED_H
+#define FOUR_VALUED_H
+
+#include <cstdint>
+
+/**
+Structure holding four-valued logic values as two bit-planes of words, bit b of the planes belongs to the same vector:
+0 is encoded as zero 1 and one 0, 1 as zero 0 and one 1, unknown X as both 1 and high impedance Z as both 0.
+Gates read Z as X, so it is turned into X already when inputs are loaded and passes unchanged only from an input node straight to an output.
+Every operation is a few bitwise operations on the planes, so the bit-parallel kernels stay the same for any Word with bitwise operators.
+*/
+template< typename Word >
+struct FourValued{
+	static constexpr int size = Word::size;/**< Number of 64-bit words of every plane*/
+	Word zero;/**< Bits set for vectors where the value may be 0*/
+	Word one;/**< Bits set for vectors where the value may be 1*/
+
+	/**	Function sets word of the planes from packed values, undefined values become X and Z is read as X.
+	@param i Index of the word.
+	@param values Packed values, 1 for Z when the value is not defined.
+	@param defined Packed flags of defined values.
+	*/
+	void load( int i, uint64_t values, uint64_t defined ){
+		this->zero.words[i] = ~( values & defined );
+		this->one.words[i] = values | ~defined;
+	}
+
+	/**	Function reads word of the planes as packed values, X is undefined value 0 and Z undefined value 1.
+	@param i Index of the word.
+	@param [out] values Packed values.
+	@param [out] defined Packed flags of defined values.
+	*/
+	void store( int i, uint64_t & values, uint64_t & defined ) const{
+		values = ~this->zero.words[i];
+		defined = this->zero.words[i] ^ this->one.words[i];
+	}
+};
+
+template< typename Word >
+inline FourValued< Word > operator&( const FourValued< Word > & a, const FourValued< Word > & b ){
+	return { a.zero | b.zero, a.one & b.one };
+}
+
+template< typename Word >
+inline FourValued< Word > operator|( const FourValued< Word > & a, const FourValued< Word > & b ){
+	return { a.zero & b.zero, a.one | b.one };
+}
+
+template< typename Word >
+inline FourValued< Word > operator^( const FourValued< Word > & a, const FourValued< Word > & b ){
+	return { ( a.zero & b.zero ) | ( a.one & b.one ), ( a.zero & b.one ) | ( a.one & b.zero ) };
+}
+
+template< typename Word >
+inline FourValued< Word > operator~( const FourValued< Word > & a ){
+	return { a.one, a.zero };
+}
+
+/**	Function creates values of a constant, X of the planes must not turn into the constant.
+	@param input1 values of any node, they only give type of the result.
+	@param value Value of the constant.
+	@return Function returns word with every vector set to the value.
+*/
+template< typename Word >
+inline FourValued< Word > evaluate_constant( const FourValued< Word > & input1, bool value ){
+	Word none = input1.zero ^ input1.zero;
+	return value ? FourValued< Word >{ none, ~none } : FourValued< Word >{ ~none, none };
+}
+
+/**	Function elaborates output values for multiplexers, known selected input passes even when the other one is X.
+	@param select values of the selecting input.
+	@param input0 values of the input passed when select is 0.
+	@param input1 values of the input passed when select is 1.
+	@return Function returns logic values of the gate.
+*/
+template< typename Word >
+inline FourValued< Word > evaluate_mux( const FourValued< Word > & select, const FourValued< Word > & input0, const FourValued< Word > & input1 ){
+	return { ( select.zero & input0.zero ) | ( select.one & input1.zero ), ( select.zero & input0.one ) | ( select.one & input1.one ) };
+}
+
+#endif
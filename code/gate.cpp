@@ -1,150 +1,108 @@
+#include <algorithm>
 #include <string>
-#include <unordered_map>
 
 #include "gate.h"
 
-/**	Function elaborates output value for input nodes.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function looks up operation performed by the gate with given name.
+	@param name Name of the gate.
+	@param [out] operation Operation performed by the gate.
+	@return Function returns false if there is no gate with such name.
 */
-bool evaluate_in( std::shared_ptr< Gate > gate ){
-	return gate->value;
-}
-
-/**	Function elaborates output value for output nodes.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_out( std::shared_ptr< Gate > gate ){
-	return gate->input1_ptr->evaluate( gate->input1_ptr );
-}
-
-/**	Function elaborates output value for negation gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_neg( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	gate->value = !gate->input1_ptr->evaluate( gate->input1_ptr );
-	gate->evaluated = true;
-	return gate->value;
-}
-
-/**	Function elaborates output value for and gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_and( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	return gate->input1_ptr->evaluate( gate->input1_ptr ) & gate->input2_ptr->evaluate( gate->input2_ptr );
-	gate->evaluated = true;
-	return gate->value;
-}
-
-/**	Function elaborates output value for nand gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_nand( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	gate->value = !( gate->input1_ptr->evaluate( gate->input1_ptr ) & gate->input2_ptr->evaluate( gate->input2_ptr ));
-	gate->evaluated = true;
-	return gate->value;
-}
-
-/**	Function elaborates output value for or gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_or( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	gate->value = gate->input1_ptr->evaluate( gate->input1_ptr ) | gate->input2_ptr->evaluate( gate->input2_ptr );
-	gate->evaluated = true;
-	return gate->value;
-}
-
-/**	Function elaborates output value for nor gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_nor( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	gate->value = !( gate->input1_ptr->evaluate( gate->input1_ptr ) | gate->input2_ptr->evaluate( gate->input2_ptr ));
-	gate->evaluated = true;
-	return gate->value;
-}
-
-/**	Function elaborates output value for xor gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_xor( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	gate->value = gate->input1_ptr->evaluate( gate->input1_ptr ) ^ gate->input2_ptr->evaluate( gate->input2_ptr );
-	gate->evaluated = true;
-	return gate->value;
-}
-
-/**	Function elaborates output value for nor gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
-*/
-bool evaluate_xnor( std::shared_ptr< Gate > gate ){
-	if(gate->evaluated)
-		return gate->value;
-	gate->value = !( gate->input1_ptr->evaluate( gate->input1_ptr ) ^ gate->input2_ptr->evaluate( gate->input2_ptr ));
-	gate->evaluated = true;
-	return gate->value;
+bool find_operation( std::string_view name, Operation & operation ){
+	//Table connecting names of the gates to operations performed by them
+	static const struct{
+		std::string_view name;
+		Operation operation;
+	} operations[] = {
+		{ "IN:", OPERATION_IN },
+		{ "OUT:", OPERATION_OUT },
+		{ "NEG", OPERATION_NEG },
+		{ "NOT", OPERATION_NEG },
+		{ "AND", OPERATION_AND },
+		{ "NAND", OPERATION_NAND },
+		{ "OR", OPERATION_OR },
+		{ "NOR", OPERATION_NOR },
+		{ "XOR", OPERATION_XOR },
+		{ "XNOR", OPERATION_XNOR },
+		{ "MUX", OPERATION_MUX },
+		{ "LUT", OPERATION_LUT },
+		{ "DFF", OPERATION_DFF },
+		{ "LATCH", OPERATION_LATCH }
+	};
+	for( const auto & entry : operations ){
+		if( entry.name == name ){
+			operation = entry.operation;
+			return true;
+		}
+	}
+	return false;
 }
 
-
 /**	Function creates new instantion of Gate structure according to the input
-	@param evaluating_functions unordered map connecting gate names with functions evaluating their values
-	@param op Name of the gate.
+	@param arena Arena the gate is created in.
+	@param operation Operation performed by the gate.
 	@param node1 First node of the gate, depending on type input1 or output.
 	@param node2 Second node of the gate, depending on type input2, output or unused.
 	@param node3 Third node of the gate, depending on type output or unused.
 	@return Function returns the pointer to freshly created instance or NULL if operation fails.
 	*/
-std::shared_ptr< Gate > Gate::create( std::unordered_map< std::string, evaluating_function > evaluating_functions, const std::string & op, int node1, int node2, int node3 ){
-	if( evaluating_functions.find( op ) == evaluating_functions.end() ){
+Gate * Gate::create( Arena & arena, Operation operation, int node1, int node2, int node3 ){
+	//Nodes are checked before the gate is created, the arena never takes memory back
+	int nodes = operation == OPERATION_IN || operation == OPERATION_OUT ? 1 : operation == OPERATION_NEG || operation == OPERATION_DFF ? 2 : 3;
+	if( node1 <= 0 || ( nodes >= 2 && node2 <= 0 ) || ( nodes >= 3 && node3 <= 0 ) ){
 		return NULL;
 	}
-	if( node1 <= 0 )
-		return NULL;
-	std::shared_ptr< Gate > gate( new Gate );
-	gate->evaluate = evaluating_functions[ op ];
-	gate->evaluated = false;
-	if( op == "IN:" ){
+	Gate * gate = arena.create< Gate >();
+	gate->operation = operation;
+	gate->level = -2;
+	if( operation == OPERATION_IN ){
 		gate->output = node1;
-		gate->input1 = 0;
-		gate->input2 = 0;
-		return gate;
-	}else if( op == "OUT:" ){
+	}else if( operation == OPERATION_OUT ){
+		gate->input1 = node1;
+	}else if( nodes == 2 ){
+		gate->input1 = node1;
+		gate->output = node2;
+	}else{
 		gate->input1 = node1;
-		gate->input2 = 0;
-		return gate;
+		gate->input2 = node2;
+		gate->output = node3;
 	}
-	if( node2 <= 0 ){
+	return gate;
+}
+
+/**	Function creates new instantion of Gate structure with any number of inputs.
+	AND, NAND, OR, NOR, XOR and XNOR gates take two or more inputs, NEG and DFF take one, LATCH takes enabling input and data input,
+	MUX takes selecting input and two data inputs, LUT takes 2 to lut_max_inputs inputs.
+	@param arena Arena the gate and the list of its further inputs are created in.
+	@param operation Operation performed by the gate.
+	@param nodes Input nodes of the gate followed by its output node.
+	@param table Truth table of lookup table, bit i holds the output when every input j has value of bit j of i.
+	@return Function returns the pointer to freshly created instance or NULL if the nodes or the table don't match the operation.
+	*/
+Gate * Gate::create( Arena & arena, Operation operation, const std::vector< int > & nodes, uint64_t table ){
+	if( nodes.empty() || operation == OPERATION_IN || operation == OPERATION_OUT ){
 		return NULL;
 	}
-	if( op == "NEG" || op == "NOT" ){
-		gate->input1 = node1;
-		gate->input2 = 0;
-		gate->output = node2;
-		return gate;
+	size_t inputs = nodes.size() - 1;
+	for( int node : nodes ){
+		if( node <= 0 ){
+			return NULL;
+		}
+	}
+	if( operation == OPERATION_NEG || operation == OPERATION_DFF ){
+		return inputs == 1 ? Gate::create( arena, operation, nodes[0], nodes[1] ) : NULL;
+	}
+	if( inputs < 2 || ( operation == OPERATION_MUX && inputs != 3 ) || ( operation == OPERATION_LATCH && inputs != 2 ) ){
+		return NULL;
 	}
-	if( node3 <= 0 ){
+	//Bits of the truth table beyond its 2^inputs entries have to be clear
+	if( operation == OPERATION_LUT && ( inputs > size_t( lut_max_inputs ) || ( inputs < size_t( lut_max_inputs ) && table >> ( 1 << inputs ) ) ) ){
 		return NULL;
 	}
-	gate->input1 = node1;
-	gate->input2 = node2;
-	gate->output = node3;
+	Gate * gate = Gate::create( arena, operation, nodes[0], nodes[1], nodes.back() );
+	gate->extra_count = inputs - 2;
+	gate->extra_inputs = arena.create_array< int >( gate->extra_count );
+	std::copy( nodes.begin() + 2, nodes.end() - 1, gate->extra_inputs );
+	gate->table = operation == OPERATION_LUT ? table : 0;
 	return gate;
 }
@@ -8,93 +8,262 @@
 #ifndef GATE_H
 #define GATE_H
 
+#include <cstdint>
 #include <iostream>
-#include <memory>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
-struct Gate;
-typedef bool ( *evaluating_function )( std::shared_ptr< Gate > ); //**<typedef of a pointer to function calculating value of gate
+#include "arena.h"
 
-/**	Function elaborates output value for input nodes.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**
+Enumeration of operations which can be performed by a gate.
 */
-bool evaluate_in( std::shared_ptr<Gate> gate );
+enum Operation{
+	OPERATION_IN,	/**< Input node, its value is set from the set of inputs*/
+	OPERATION_OUT,	/**< Output node, it copies value of its input*/
+	OPERATION_NEG,	/**< Negation gate*/
+	OPERATION_AND,	/**< And gate*/
+	OPERATION_NAND,	/**< Nand gate*/
+	OPERATION_OR,	/**< Or gate*/
+	OPERATION_NOR,	/**< Nor gate*/
+	OPERATION_XOR,	/**< Xor gate*/
+	OPERATION_XNOR,	/**< Xnor gate*/
+	OPERATION_ZERO,	/**< Constant 0, created only by optimization of the circuit*/
+	OPERATION_ONE,	/**< Constant 1, created only by optimization of the circuit*/
+	OPERATION_MUX,	/**< Multiplexer, the first input selects the second input when it is 0 and the third one when it is 1*/
+	OPERATION_LUT,	/**< Lookup table with 2 to 6 inputs, its output is given by a truth table*/
+	OPERATION_DFF,	/**< D flip-flop, it outputs value its input had in the previous clock cycle, 0 in the first one (X in four-valued simulation)*/
+	OPERATION_LATCH	/**< Latch, it passes the second input while the first one is 1 and keeps its last value while it is 0*/
+};
+
+static const int lut_max_inputs = 6;	//**<Maximal number of inputs of a lookup table, so its truth table fits a 64-bit word
 
-/**	Function elaborates output value for output nodes.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function tells how many inputs of the operation are held in the first two input fields.
+	Wide gates, multiplexers and lookup tables list their further inputs separately.
+	@param operation One of Operation values.
+	@return Function returns number of inputs held in the first two fields.
 */
-bool evaluate_out( std::shared_ptr<Gate> gate );
+inline int operation_inputs( uint8_t operation ){
+	switch( operation ){
+		case OPERATION_IN:
+		case OPERATION_ZERO:
+		case OPERATION_ONE:
+			return 0;
+		case OPERATION_OUT:
+		case OPERATION_NEG:
+		case OPERATION_DFF:
+			return 1;
+		default:
+			return 2;
+	}
+}
 
-/**	Function elaborates output value for negation gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function splits operation of a gate into associative base operation and negation of its output.
+	@param operation One of AND, NAND, OR, NOR, XOR and XNOR operations.
+	@param [out] negated True if output of the base operation is negated.
+	@return Function returns OPERATION_AND, OPERATION_OR or OPERATION_XOR.
 */
-bool evaluate_neg( std::shared_ptr<Gate> gate );
+inline uint8_t base_operation( uint8_t operation, bool & negated ){
+	negated = operation == OPERATION_NAND || operation == OPERATION_NOR || operation == OPERATION_XNOR;
+	if( operation == OPERATION_AND || operation == OPERATION_NAND ){
+		return OPERATION_AND;
+	}
+	return operation == OPERATION_OR || operation == OPERATION_NOR ? OPERATION_OR : OPERATION_XOR;
+}
 
-/**	Function elaborates output value for and gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function looks up operation performed by the gate with given name.
+	@param name Name of the gate.
+	@param [out] operation Operation performed by the gate.
+	@return Function returns false if there is no gate with such name.
 */
-bool evaluate_and( std::shared_ptr<Gate> gate );
+bool find_operation( std::string_view name, Operation & operation );
 
-/**	Function elaborates output value for nand gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function creates values of a constant, every bit of the word is a separate input vector.
+	@param input1 values of any node, they only give type of the result.
+	@param value Value of the constant.
+	@return Function returns word with every vector set to the value.
 */
-bool evaluate_nand( std::shared_ptr<Gate> gate );
+template< typename Word >
+inline Word evaluate_constant( const Word & input1, bool value ){
+	Word zero = input1 ^ input1;
+	return value ? Word( ~zero ) : zero;
+}
 
-/**	Function elaborates output value for or gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function elaborates output values for negation gates, every bit of the word is a separate input vector.
+	@param input1 values of the input.
+	@return Function returns logic values of the gate.
 */
-bool evaluate_or( std::shared_ptr<Gate> gate );
+template< typename Word >
+inline Word evaluate_neg( const Word & input1 ){
+	return ~input1;
+}
 
-/**	Function elaborates output value for nor gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function elaborates output values for and gates, every bit of the word is a separate input vector.
+	@param input1 values of the first input.
+	@param input2 values of the second input.
+	@return Function returns logic values of the gate.
 */
-bool evaluate_nor( std::shared_ptr<Gate> gate );
+template< typename Word >
+inline Word evaluate_and( const Word & input1, const Word & input2 ){
+	return input1 & input2;
+}
 
-/**	Function elaborates output value for xor gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function elaborates output values for nand gates, every bit of the word is a separate input vector.
+	@param input1 values of the first input.
+	@param input2 values of the second input.
+	@return Function returns logic values of the gate.
 */
-bool evaluate_xor( std::shared_ptr<Gate> gate );
+template< typename Word >
+inline Word evaluate_nand( const Word & input1, const Word & input2 ){
+	return ~( input1 & input2 );
+}
 
-/**	Function elaborates output value for nor gates.
-	@param gate pointer to gate to be evaluated.
-	@return Function returns logic value of the gate.
+/**	Function elaborates output values for or gates, every bit of the word is a separate input vector.
+	@param input1 values of the first input.
+	@param input2 values of the second input.
+	@return Function returns logic values of the gate.
 */
-bool evaluate_xnor( std::shared_ptr<Gate> gate );
+template< typename Word >
+inline Word evaluate_or( const Word & input1, const Word & input2 ){
+	return input1 | input2;
+}
 
+/**	Function elaborates output values for nor gates, every bit of the word is a separate input vector.
+	@param input1 values of the first input.
+	@param input2 values of the second input.
+	@return Function returns logic values of the gate.
+*/
+template< typename Word >
+inline Word evaluate_nor( const Word & input1, const Word & input2 ){
+	return ~( input1 | input2 );
+}
+
+/**	Function elaborates output values for xor gates, every bit of the word is a separate input vector.
+	@param input1 values of the first input.
+	@param input2 values of the second input.
+	@return Function returns logic values of the gate.
+*/
+template< typename Word >
+inline Word evaluate_xor( const Word & input1, const Word & input2 ){
+	return input1 ^ input2;
+}
+
+/**	Function elaborates output values for xnor gates, every bit of the word is a separate input vector.
+	@param input1 values of the first input.
+	@param input2 values of the second input.
+	@return Function returns logic values of the gate.
+*/
+template< typename Word >
+inline Word evaluate_xnor( const Word & input1, const Word & input2 ){
+	return ~( input1 ^ input2 );
+}
+
+/**	Function elaborates output values for multiplexers, every bit of the word is a separate input vector.
+	@param select values of the selecting input.
+	@param input0 values of the input passed when select is 0.
+	@param input1 values of the input passed when select is 1.
+	@return Function returns logic values of the gate.
+*/
+template< typename Word >
+inline Word evaluate_mux( const Word & select, const Word & input0, const Word & input1 ){
+	return input0 ^ ( ( input0 ^ input1 ) & select );
+}
+
+/**	Function elaborates output values for lookup tables, every bit of the word is a separate input vector.
+	Entries of the truth table are reduced by one input at a time, every step selects between pairs of entries differing only in that input.
+	@param table Truth table, bit i holds the output when every input j has value of bit j of i.
+	@param inputs values of the inputs.
+	@param count Number of inputs, at most lut_max_inputs.
+	@return Function returns logic values of the gate.
+*/
+template< typename Word >
+inline Word evaluate_lut( uint64_t table, const Word * inputs, int count ){
+	Word zero = evaluate_constant( inputs[0], false );
+	Word one = evaluate_constant( inputs[0], true );
+	Word entries[ 1 << lut_max_inputs ];
+	for( int i = 0; i < 1 << count; i++ ){
+		entries[i] = ( table >> i ) & 1 ? one : zero;
+	}
+	for( int input = 0; input < count; input++ ){
+		for( int i = 0; i < 1 << ( count - input - 1 ); i++ ){
+			entries[i] = evaluate_mux( inputs[ input ], entries[ 2 * i ], entries[ 2 * i + 1 ] );
+		}
+	}
+	return entries[0];
+}
+
+/**	Function elaborates output values of a gate performing given operation.
+	@param operation Operation performed by the gate, one of Operation values.
+	@param input1 values of the first input.
+	@param input2 values of the second input, ignored by single input gates.
+	@return Function returns logic values of the gate, multiplexers, lookup tables, flip-flops and latches are evaluated by their own functions.
+*/
+template< typename Word >
+inline Word evaluate_operation( uint8_t operation, const Word & input1, const Word & input2 ){
+	switch( operation ){
+		case OPERATION_NEG:
+			return evaluate_neg( input1 );
+		case OPERATION_AND:
+			return evaluate_and( input1, input2 );
+		case OPERATION_NAND:
+			return evaluate_nand( input1, input2 );
+		case OPERATION_OR:
+			return evaluate_or( input1, input2 );
+		case OPERATION_NOR:
+			return evaluate_nor( input1, input2 );
+		case OPERATION_XOR:
+			return evaluate_xor( input1, input2 );
+		case OPERATION_XNOR:
+			return evaluate_xnor( input1, input2 );
+		case OPERATION_ZERO:
+			return evaluate_constant( input1, false );
+		case OPERATION_ONE:
+			return evaluate_constant( input1, true );
+		default:
+			return input1;
+	}
+}
 
 /**
 A structure that represents single logical gate in the circuit with it's connections to other gates.
+It is used only while the circuit is being built, evaluation is done on the levelized netlist.
+Gates and their lists of further inputs live in the arena of the circuit, so they only refer to each other and are released all at once.
 */
 struct Gate{
-	std::shared_ptr< Gate > input1_ptr;/**< Pointer to gate which is the first input*/
-	std::shared_ptr< Gate > input2_ptr;/**< Pointer to gate which is the second input*/
+	Gate * input1_ptr;/**< Pointer to gate which is the first input*/
+	Gate * input2_ptr;/**< Pointer to gate which is the second input*/
+	Gate ** extra_inputs_ptr;/**< Pointers to gates which are the further inputs, extra_count of them*/
 
 	int input1;/**< Number of first input node*/
 	int input2;/**< Number of second input node*/
+	int * extra_inputs;/**< Numbers of further input nodes of wide gates, multiplexers and lookup tables, extra_count of them*/
+	uint32_t extra_count;/**< Number of further input nodes*/
 	int output;/**< Number of output node*/
 
-	bool value;/**< Logical value of output*/
-	bool evaluated;/**< Flag set if the gate has been evaluated for current inputs*/
-
-	evaluating_function evaluate;/**< Pointer to function which elaborates output value depending on inputs and type of gate*/
+	Operation operation;/**< Operation performed by the gate*/
+	uint64_t table;/**< Truth table of lookup table, 0 for other operations*/
+	int level;/**< Level of the gate found while the circuit is compiled, -2 before the gate is visited and -1 while it is on the current path of the search*/
 
 	/**	Function creates new instantion of Gate structure according to the input
-	@param evaluating_functions unordered map connecting gate names with functions evaluating their values
-	@param op Name of the gate.
+	@param arena Arena the gate is created in.
+	@param operation Operation performed by the gate.
 	@param node1 First node of the gate, depending on type input1 or output.
 	@param node2 Second node of the gate, depending on type input2, output or unused.
 	@param node3 Third node of the gate, depending on type output or unused.
 	@return Function returns the pointer to freshly created instance or NULL if operation fails.
 	*/
-	static std::shared_ptr< Gate > create( std::unordered_map< std::string, evaluating_function > evaluating_functions, const std::string & op, int node1, int node2 = 0, int node3 = 0 );
+	static Gate * create( Arena & arena, Operation operation, int node1, int node2 = 0, int node3 = 0 );
+
+	/**	Function creates new instantion of Gate structure with any number of inputs.
+	AND, NAND, OR, NOR, XOR and XNOR gates take two or more inputs, NEG and DFF take one, LATCH takes enabling input and data input,
+	MUX takes selecting input and two data inputs, LUT takes 2 to lut_max_inputs inputs.
+	@param arena Arena the gate and the list of its further inputs are created in.
+	@param operation Operation performed by the gate.
+	@param nodes Input nodes of the gate followed by its output node.
+	@param table Truth table of lookup table, bit i holds the output when every input j has value of bit j of i.
+	@return Function returns the pointer to freshly created instance or NULL if the nodes or the table don't match the operation.
+	*/
+	static Gate * create( Arena & arena, Operation operation, const std::vector< int > & nodes, uint64_t table = 0 );
 };
 
-#endif
\ No newline at end of file
+#endif
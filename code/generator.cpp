@@ -0,0 +1,354 @@
+/**
+ * @file generator.cpp
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief Tool generating parameterized circuits and random input vectors for benchmarking.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+	Class collecting gates of generated circuit and numbering its nodes.
+*/
+class Netlist_writer
+{
+	std::vector< int > inputs;		//**<Numbers of input nodes
+	std::vector< int > outputs;		//**<Numbers of output nodes
+	std::ostringstream gates;		//**<Text of the gate lines
+	int next;						//**<Number of the next created node
+
+public:
+	Netlist_writer(){
+		this->next = 1;
+	}
+
+	/**
+		@return Method returns number of the created input node.
+	*/
+	int input(){
+		this->inputs.push_back( this->next );
+		return this->next++;
+	}
+
+	/** Method marks node as an output.
+		@param node Number of the node.
+	*/
+	void output( int node ){
+		this->outputs.push_back( node );
+	}
+
+	/** Method creates gate.
+		@param operation Name of the gate.
+		@param input1 Number of the first input node.
+		@param input2 Number of the second input node, ignored by NEG.
+		@return Method returns number of the output node of the gate.
+	*/
+	int gate( const std::string & operation, int input1, int input2 = 0 ){
+		this->gates<<operation<<" "<<input1<<" ";
+		if( operation != "NEG" ){
+			this->gates<<input2<<" ";
+		}
+		this->gates<<this->next<<"\n";
+		return this->next++;
+	}
+
+	/** Method writes the circuit in the format read by the simulator.
+		@param file Stream where the circuit is written.
+	*/
+	void write( std::ostream & file ){
+		file<<"IN:";
+		for( int node : this->inputs ){
+			file<<" "<<node;
+		}
+		file<<"\nOUT:";
+		for( int node : this->outputs ){
+			file<<" "<<node;
+		}
+		file<<"\n\n"<<this->gates.str();
+	}
+};
+
+/** Function creates full adder.
+	@param writer Circuit being generated.
+	@param a First bit.
+	@param b Second bit.
+	@param [in,out] carry Incoming carry, replaced by the outgoing one.
+	@return Function returns node holding the sum.
+*/
+int full_adder( Netlist_writer & writer, int a, int b, int & carry ){
+	int half = writer.gate( "XOR", a, b );
+	int sum = writer.gate( "XOR", half, carry );
+	carry = writer.gate( "OR", writer.gate( "AND", a, b ), writer.gate( "AND", half, carry ) );
+	return sum;
+}
+
+/** Function generates ripple carry adder.
+	@param writer Circuit being generated.
+	@param bits Width of the operands.
+*/
+void ripple_adder( Netlist_writer & writer, int bits ){
+	std::vector< int > a( bits ), b( bits );
+	for( int & node : a ){
+		node = writer.input();
+	}
+	for( int & node : b ){
+		node = writer.input();
+	}
+	int carry = writer.input();
+	for( int i = 0; i < bits; i++ ){
+		writer.output( full_adder( writer, a[i], b[i], carry ) );
+	}
+	writer.output( carry );
+}
+
+/** Function generates carry lookahead adder with Kogge-Stone parallel prefix carry network.
+	@param writer Circuit being generated.
+	@param bits Width of the operands.
+*/
+void lookahead_adder( Netlist_writer & writer, int bits ){
+	std::vector< int > a( bits ), b( bits );
+	for( int & node : a ){
+		node = writer.input();
+	}
+	for( int & node : b ){
+		node = writer.input();
+	}
+	int carry = writer.input();
+	std::vector< int > propagate( bits ), generate( bits );
+	for( int i = 0; i < bits; i++ ){
+		propagate[i] = writer.gate( "XOR", a[i], b[i] );
+		generate[i] = writer.gate( "AND", a[i], b[i] );
+	}
+	//Incoming carry is folded into the lowest generate signal
+	std::vector< int > group_propagate( propagate ), group_generate( generate );
+	group_generate[0] = writer.gate( "OR", generate[0], writer.gate( "AND", propagate[0], carry ) );
+	for( int distance = 1; distance < bits; distance *= 2 ){
+		std::vector< int > next_propagate( group_propagate ), next_generate( group_generate );
+		for( int i = distance; i < bits; i++ ){
+			int low = i - distance;
+			next_generate[i] = writer.gate( "OR", group_generate[i], writer.gate( "AND", group_propagate[i], group_generate[low] ) );
+			if( low >= distance ){
+				next_propagate[i] = writer.gate( "AND", group_propagate[i], group_propagate[low] );
+			}
+		}
+		group_propagate.swap( next_propagate );
+		group_generate.swap( next_generate );
+	}
+	for( int i = 0; i < bits; i++ ){
+		writer.output( writer.gate( "XOR", propagate[i], i == 0 ? carry : group_generate[i - 1] ) );
+	}
+	writer.output( group_generate[bits - 1] );
+}
+
+/** Function adds two or three bits, missing bits are marked with 0.
+	@param writer Circuit being generated.
+	@param a First bit.
+	@param b Second bit.
+	@param [in,out] carry Incoming carry, replaced by the outgoing one.
+	@return Function returns node holding the sum.
+*/
+int adder( Netlist_writer & writer, int a, int b, int & carry ){
+	if( b == 0 ){
+		std::swap( b, carry );
+	}
+	if( b == 0 ){
+		return a;
+	}
+	if( carry == 0 ){
+		carry = writer.gate( "AND", a, b );
+		return writer.gate( "XOR", a, b );
+	}
+	return full_adder( writer, a, b, carry );
+}
+
+/** Function generates array multiplier.
+	@param writer Circuit being generated.
+	@param bits Width of the operands.
+*/
+void multiplier( Netlist_writer & writer, int bits ){
+	std::vector< int > a( bits ), b( bits );
+	for( int & node : a ){
+		node = writer.input();
+	}
+	for( int & node : b ){
+		node = writer.input();
+	}
+	//Each row of partial products is added to the accumulated sum shifted by one bit
+	std::vector< int > sum( bits );
+	int high = 0;
+	for( int j = 0; j < bits; j++ ){
+		std::vector< int > next( bits );
+		int carry = 0;
+		for( int i = 0; i < bits; i++ ){
+			int product = writer.gate( "AND", a[i], b[j] );
+			next[i] = adder( writer, product, j == 0 ? 0 : i + 1 < bits ? sum[i + 1] : high, carry );
+		}
+		high = carry;
+		writer.output( next[0] );
+		sum.swap( next );
+	}
+	for( int i = 1; i < bits; i++ ){
+		writer.output( sum[i] );
+	}
+	if( high != 0 ){
+		writer.output( high );
+	}
+}
+
+/** Function generates random acyclic circuit.
+	Gates are spread evenly over the levels, the first input of each gate comes from the previous level so the circuit has exactly the requested depth.
+	Nodes which drive no gate become outputs.
+	@param writer Circuit being generated.
+	@param input_count Number of inputs.
+	@param gate_count Number of gates.
+	@param depth Number of levels.
+	@param fanout Maximal number of gates driven by a single node.
+	@param random Source of random numbers.
+*/
+void random_dag( Netlist_writer & writer, int input_count, int gate_count, int depth, int fanout, std::mt19937_64 & random ){
+	const std::vector< std::string > operations = { "AND", "NAND", "OR", "NOR", "XOR", "XNOR", "NEG" };
+	std::vector< int > nodes;
+	std::vector< int > loads;
+	std::vector< size_t > level_begin;
+	level_begin.push_back( 0 );
+	for( int i = 0; i < input_count; i++ ){
+		nodes.push_back( writer.input() );
+		loads.push_back( 0 );
+	}
+	//Picks node from range [begin, end) preferring nodes below the fanout limit
+	auto pick = [ & ]( size_t begin, size_t end ){
+		size_t index = begin + random() % ( end - begin );
+		for( int attempt = 0; attempt < 8 && loads[index] >= fanout; attempt++ ){
+			index = begin + random() % ( end - begin );
+		}
+		loads[index]++;
+		return index;
+	};
+	//Nodes which do not drive any gate yet are preferred as the second input, so few of them are left as outputs
+	std::vector< size_t > unused;
+	for( int level = 0; level < depth; level++ ){
+		size_t previous = level_begin.back();
+		size_t begin = nodes.size();
+		level_begin.push_back( begin );
+		for( size_t i = previous; i < begin; i++ ){
+			unused.push_back( i );
+		}
+		int count = gate_count / depth + ( level < gate_count % depth );
+		for( int i = 0; i < std::max( count, 1 ); i++ ){
+			const std::string & operation = operations[ random() % operations.size() ];
+			int input1 = nodes[ pick( previous, begin ) ];
+			size_t second = begin;
+			while( !unused.empty() && second == begin ){
+				size_t position = random() % unused.size();
+				if( loads[ unused[position] ] == 0 ){
+					second = unused[position];
+					loads[second]++;
+				}
+				unused[position] = unused.back();
+				unused.pop_back();
+			}
+			if( second == begin ){
+				second = pick( 0, begin );
+			}
+			nodes.push_back( writer.gate( operation, input1, nodes[second] ) );
+			loads.push_back( 0 );
+		}
+	}
+	for( size_t i = input_count; i < nodes.size(); i++ ){
+		if( loads[i] == 0 ){
+			writer.output( nodes[i] );
+		}
+	}
+}
+
+/** Function writes random input vectors for the inputs of the circuit.
+	@param circuit_fname Name of the circuit file.
+	@param count Number of vectors.
+	@param random Source of random numbers.
+	@return Function returns false if the circuit file could not be read.
+*/
+bool random_vectors( const std::string & circuit_fname, long count, std::mt19937_64 & random ){
+	std::ifstream file( circuit_fname );
+	std::string line;
+	while( std::getline( file, line ) && line.rfind( "IN:", 0 ) != 0 );
+	if( !file ){
+		return false;
+	}
+	std::vector< std::string > inputs;
+	std::istringstream stream( line.substr( 3 ) );
+	std::string node;
+	while( stream>>node ){
+		inputs.push_back( node );
+	}
+	std::string text;
+	for( long i = 0; i < count; i++ ){
+		text.clear();
+		uint64_t bits = 0;
+		for( size_t j = 0; j < inputs.size(); j++ ){
+			if( j % 64 == 0 ){
+				bits = random();
+			}
+			text += inputs[j];
+			text += ( bits >> j % 64 ) & 1 ? ":1 " : ":0 ";
+		}
+		text += '\n';
+		std::cout<<text;
+	}
+	return true;
+}
+
+int main( int argc, char **argv ){
+	const std::string usage = "Usage: generator <kind> <parameters> [seed]\nAvailable kinds are:\n\t"
+	"ripple <bits>\t\t\t\tRipple carry adder\n\t"
+	"lookahead <bits>\t\t\tCarry lookahead adder\n\t"
+	"multiplier <bits>\t\t\tArray multiplier\n\t"
+	"random <inputs> <gates> <depth> <fanout>\tRandom acyclic circuit\n\t"
+	"vectors <circuit file> <count>\t\tRandom input vectors for the circuit\n"
+	"Generated text is written to the standard output.\n";
+
+	std::vector< std::string > arguments( argv + 1, argv + argc );
+	const std::vector< std::pair< std::string, size_t > > kinds = { { "ripple", 1 }, { "lookahead", 1 }, { "multiplier", 1 }, { "random", 4 }, { "vectors", 2 } };
+	auto kind = std::find_if( kinds.begin(), kinds.end(), [ & ]( const auto & k ){ return !arguments.empty() && k.first == arguments[0]; } );
+	if( kind == kinds.end() || ( arguments.size() != kind->second + 1 && arguments.size() != kind->second + 2 ) ){
+		std::cout<<usage;
+		return 1;
+	}
+	std::vector< long > numbers;
+	for( size_t i = 1; i < arguments.size(); i++ ){
+		if( kind->first == "vectors" && i == 1 ){
+			continue;
+		}
+		if( arguments[i].empty() || arguments[i].find_first_not_of( "0123456789" ) != std::string::npos || arguments[i].size() > 9 || std::stol( arguments[i] ) < 1 ){
+			std::cout<<"error: incorrect parameter: '"<<arguments[i]<<"'\n";
+			return 1;
+		}
+		numbers.push_back( std::stol( arguments[i] ) );
+	}
+	std::mt19937_64 random( arguments.size() == kind->second + 2 ? numbers.back() : 1 );
+
+	std::ios::sync_with_stdio( false );
+	Netlist_writer writer;
+	if( kind->first == "ripple" ){
+		ripple_adder( writer, numbers[0] );
+	}else if( kind->first == "lookahead" ){
+		lookahead_adder( writer, numbers[0] );
+	}else if( kind->first == "multiplier" ){
+		multiplier( writer, numbers[0] );
+	}else if( kind->first == "random" ){
+		random_dag( writer, numbers[0], numbers[1], numbers[2], numbers[3], random );
+	}else{
+		if( !random_vectors( arguments[1], numbers[0], random ) ){
+			std::cout<<"error: Couldn't read inputs of circuit: "<<arguments[1]<<"\n";
+			return 1;
+		}
+		return 0;
+	}
+	writer.write( std::cout );
+	return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file lanes.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of the word type used for bit-parallel simulation.
+ */
+
+#ifndef LANES_H
+#define LANES_H
+
+#include <cstdint>
+
+#if defined( __AVX2__ ) || defined( __AVX512F__ )
+#include <immintrin.h>
+#endif
+
+/**
+Structure holding values of a node for 64 * N input vectors, bit b of words[w] belongs to vector 64 * w + b.
+Gate kernels are built from bitwise operators, so every operation evaluates whole word of vectors at once.
+Operators for 256 and 512 vectors are mapped to AVX2 and AVX-512 instructions when the compiler targets them.
+*/
+template< int N >
+struct alignas( 8 * N ) Lanes{
+	static constexpr int size = N;/**< Number of 64-bit words*/
+	uint64_t words[ N ];/**< Packed values, one bit per vector*/
+
+	/**	Function sets word of the lanes from packed values, undefined values become 0.
+	@param i Index of the word.
+	@param values Packed values.
+	@param defined Packed flags of defined values.
+	*/
+	void load( int i, uint64_t values, uint64_t defined ){
+		this->words[i] = values & defined;
+	}
+
+	/**	Function reads word of the lanes as packed values, all of them defined.
+	@param i Index of the word.
+	@param [out] values Packed values.
+	@param [out] defined Packed flags of defined values.
+	*/
+	void store( int i, uint64_t & values, uint64_t & defined ) const{
+		values = this->words[i];
+		defined = ~uint64_t( 0 );
+	}
+
+	/**
+	@return Function returns true if any bit of the lanes is set.
+	*/
+	bool any() const{
+		uint64_t bits = 0;
+		for( int i = 0; i < N; i++ ){
+			bits |= this->words[i];
+		}
+		return bits != 0;
+	}
+
+	/**	Function creates lanes with every bit set to the same value.
+	@param value Value of every bit.
+	@return Function returns filled lanes.
+	*/
+	static Lanes broadcast( bool value ){
+		Lanes lanes;
+		for( int i = 0; i < N; i++ ){
+			lanes.words[i] = value ? ~uint64_t( 0 ) : 0;
+		}
+		return lanes;
+	}
+};
+
+template< int N >
+inline Lanes< N > operator&( const Lanes< N > & a, const Lanes< N > & b ){
+	Lanes< N > result;
+	for( int i = 0; i < N; i++ ){
+		result.words[i] = a.words[i] & b.words[i];
+	}
+	return result;
+}
+
+template< int N >
+inline Lanes< N > operator|( const Lanes< N > & a, const Lanes< N > & b ){
+	Lanes< N > result;
+	for( int i = 0; i < N; i++ ){
+		result.words[i] = a.words[i] | b.words[i];
+	}
+	return result;
+}
+
+template< int N >
+inline Lanes< N > operator^( const Lanes< N > & a, const Lanes< N > & b ){
+	Lanes< N > result;
+	for( int i = 0; i < N; i++ ){
+		result.words[i] = a.words[i] ^ b.words[i];
+	}
+	return result;
+}
+
+template< int N >
+inline Lanes< N > operator~( const Lanes< N > & a ){
+	Lanes< N > result;
+	for( int i = 0; i < N; i++ ){
+		result.words[i] = ~a.words[i];
+	}
+	return result;
+}
+
+#if defined( __AVX2__ )
+template<>
+inline Lanes< 4 > operator&( const Lanes< 4 > & a, const Lanes< 4 > & b ){
+	Lanes< 4 > result;
+	_mm256_store_si256( ( __m256i * )result.words, _mm256_and_si256( _mm256_load_si256( ( const __m256i * )a.words ), _mm256_load_si256( ( const __m256i * )b.words ) ) );
+	return result;
+}
+
+template<>
+inline Lanes< 4 > operator|( const Lanes< 4 > & a, const Lanes< 4 > & b ){
+	Lanes< 4 > result;
+	_mm256_store_si256( ( __m256i * )result.words, _mm256_or_si256( _mm256_load_si256( ( const __m256i * )a.words ), _mm256_load_si256( ( const __m256i * )b.words ) ) );
+	return result;
+}
+
+template<>
+inline Lanes< 4 > operator^( const Lanes< 4 > & a, const Lanes< 4 > & b ){
+	Lanes< 4 > result;
+	_mm256_store_si256( ( __m256i * )result.words, _mm256_xor_si256( _mm256_load_si256( ( const __m256i * )a.words ), _mm256_load_si256( ( const __m256i * )b.words ) ) );
+	return result;
+}
+
+template<>
+inline Lanes< 4 > operator~( const Lanes< 4 > & a ){
+	Lanes< 4 > result;
+	_mm256_store_si256( ( __m256i * )result.words, _mm256_xor_si256( _mm256_load_si256( ( const __m256i * )a.words ), _mm256_set1_epi64x( -1 ) ) );
+	return result;
+}
+#endif
+
+#if defined( __AVX512F__ )
+template<>
+inline Lanes< 8 > operator&( const Lanes< 8 > & a, const Lanes< 8 > & b ){
+	Lanes< 8 > result;
+	_mm512_store_si512( result.words, _mm512_and_si512( _mm512_load_si512( a.words ), _mm512_load_si512( b.words ) ) );
+	return result;
+}
+
+template<>
+inline Lanes< 8 > operator|( const Lanes< 8 > & a, const Lanes< 8 > & b ){
+	Lanes< 8 > result;
+	_mm512_store_si512( result.words, _mm512_or_si512( _mm512_load_si512( a.words ), _mm512_load_si512( b.words ) ) );
+	return result;
+}
+
+template<>
+inline Lanes< 8 > operator^( const Lanes< 8 > & a, const Lanes< 8 > & b ){
+	Lanes< 8 > result;
+	_mm512_store_si512( result.words, _mm512_xor_si512( _mm512_load_si512( a.words ), _mm512_load_si512( b.words ) ) );
+	return result;
+}
+
+template<>
+inline Lanes< 8 > operator~( const Lanes< 8 > & a ){
+	Lanes< 8 > result;
+	_mm512_store_si512( result.words, _mm512_xor_si512( _mm512_load_si512( a.words ), _mm512_set1_epi64( -1 ) ) );
+	return result;
+}
+#endif
+
+#endif
@@ -9,53 +9,217 @@
 
 #include "circuit.h"
 #include "parse_options.h"
+#include "server.h"
+#include "stats.h"
 
 
+/** Function prints and writes statistics of the simulation if they were requested.
+	@param options Settings read from command line parameters.
+	@param stats Measured phases of the simulation.
+	@param circuit Simulated circuit.
+*/
+void report_stats( const Options & options, const Stats & stats, Circuit & circuit ){
+	if( options.stats ){
+		std::cout<<stats.report( circuit.get_counters(), circuit.get_netlist() );
+	}
+	if( options.stats_file != "" ){
+		std::string error = stats.write_json( options.stats_file, circuit.get_counters(), circuit.get_netlist() );
+		if( error != "" ){
+			std::cout<<error<<std::endl;
+		}
+	}
+}
 
-int main( int argc, char **argv ){
 
-	std::string input_file;
-	std::string circuit_file;
-	std::string output_file;
+int main( int argc, char **argv ){
 
+	Options options;
 
-	std::string parse_error = parse_options( argc, argv, input_file, circuit_file, output_file );
+	std::string parse_error = parse_options( argc, argv, options );
 	if( parse_error != "" ){
 		std::cout<<parse_error;
 		return 0;
 	}
 
 
+	//Number of built circuits kept by the server
+	const size_t server_cache = 16;
+	if( options.server_socket != "" ){
+		Server server( options.server_socket, options.threads, server_cache );
+		std::cout<<server.run()<<std::endl;
+		return 0;
+	}
+	if( options.client_socket != "" ){
+		std::string error = Server::request( options.client_socket, options );
+		if( error != "" ){
+			std::cout<<error<<std::endl;
+		}
+		return 0;
+	}
+
+	Stats stats;
 	Circuit circuit;
-	circuit.build( circuit_file );
-	
+	circuit.set_width( options.width );
+	circuit.set_threads( options.threads );
+	circuit.set_testbenches( options.testbenches );
+	circuit.set_binary_output( options.binary_output );
+	circuit.set_event_driven( options.event_driven );
+	circuit.set_four_valued( options.four_valued );
+	circuit.set_activity( options.activity_file != "" );
+	stats.begin( "build" );
+	circuit.build( options.circuit_file );
+	stats.end();
+
 	if( !circuit.good() ){
 		for( const auto & error : circuit.get_errors() ){
 			std::cout<<error<<std::endl;
 		}
 		return 0;
 	}
-	circuit.readInputs( input_file );
+	if( !options.outputs.empty() && !circuit.select_outputs( options.outputs ) ){
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		return 0;
+	}
+	if( options.optimize ){
+		stats.begin( "optimize" );
+		circuit.optimize();
+		stats.end();
+	}
+	if( options.compile ){
+		circuit.save( options.output_file );
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		return 0;
+	}
+	if( options.native ){
+		stats.begin( "compile_native" );
+		circuit.compile_native();
+		stats.end();
+	}
+	if( options.delays_file != "" && !circuit.read_delays( options.delays_file ) ){
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		return 0;
+	}
+	if( options.waveform_file != "" && !circuit.open_waveform( options.waveform_file, options.waveform_nodes, options.waveform_min_level, options.waveform_max_level ) ){
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		return 0;
+	}
+	if( options.equivalent_file != "" ){
+		Circuit other;
+		other.set_width( options.width );
+		other.set_threads( options.threads );
+		other.set_event_driven( options.event_driven );
+		other.set_four_valued( options.four_valued );
+		other.build( options.equivalent_file );
+		if( options.optimize && other.good() ){
+			other.optimize();
+		}
+		for( const auto & error : other.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		if( !other.good() ){
+			return 0;
+		}
+		std::string result;
+		stats.begin( "compare" );
+		circuit.check_equivalence( other, result );
+		stats.end();
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		if( result != "" ){
+			std::cout<<result<<std::endl;
+		}
+		report_stats( options, stats, circuit );
+		return 0;
+	}
+	if( options.exhaustive ){
+		stats.begin( "enumerate" );
+		circuit.enumerate( options.output_file );
+		stats.end();
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		report_stats( options, stats, circuit );
+		return 0;
+	}
+	if( options.packed_file != "" ){
+		circuit.readInputs( options.input_file );
+		circuit.writeInputs( options.packed_file );
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		return 0;
+	}
+	if( options.batch_size ){
+		stats.begin( "simulate" );
+		circuit.simulate( options.input_file, options.output_file, options.batch_size );
+		stats.end();
+		circuit.close_waveform();
+		if( options.activity_file != "" && circuit.good() ){
+			circuit.write_activity( options.activity_file );
+		}
+		for( const auto & error : circuit.get_errors() ){
+			std::cout<<error<<std::endl;
+		}
+		report_stats( options, stats, circuit );
+		return 0;
+	}
+	stats.begin( "readInputs" );
+	circuit.readInputs( options.input_file );
+	stats.end();
 	for( const auto & error : circuit.get_errors() ){
 		std::cout<<error<<std::endl;
 	}
 	if( !circuit.good() ){	
 		return 0;
 	}
+	if( options.faults ){
+		stats.begin( "faults" );
+		circuit.grade_faults( options.output_file );
+		stats.end();
+		if( !circuit.good() ){
+			for( const auto & error : circuit.get_errors() ){
+				std::cout<<error<<std::endl;
+			}
+			return 0;
+		}
+		report_stats( options, stats, circuit );
+		return 0;
+	}
+	stats.begin( "evaluate" );
 	circuit.evaluate();
+	stats.end();
 	if( !circuit.good() ){
 		for( const auto & error : circuit.get_errors() ){
 			std::cout<<error<<std::endl;
 		}
 		return 0;
 	}
-	circuit.writeOutputs( output_file );
+	stats.begin( "writeOutputs" );
+	circuit.writeOutputs( options.output_file );
+	stats.end();
+	circuit.close_waveform();
+	if( options.toggles_file != "" ){
+		circuit.write_toggles( options.toggles_file );
+	}
+	if( options.activity_file != "" ){
+		circuit.write_activity( options.activity_file );
+	}
 	if( !circuit.good() ){
 		for( const auto & error : circuit.get_errors() ){
 			std::cout<<error<<std::endl;
 		}
 		return 0;
 	}
+	report_stats( options, stats, circuit );
 	return 0;
 } 
 
@@ -0,0 +1,106 @@
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.h"
+
+/**
+	Constructor with no parameters.
+*/
+MappedFile::MappedFile(){
+	this->descriptor = -1;
+	this->_data = NULL;
+	this->_size = 0;
+}
+
+/**
+	Destructor unmapping the file.
+*/
+MappedFile::~MappedFile(){
+	this->close();
+}
+
+/**
+	Method maps the file into memory, file which is not a regular file is read into the buffer.
+	@param fname Name of the file.
+	@return Method returns true if the file has been mapped or read, false if it couldn't be opened.
+*/
+bool MappedFile::open( const std::string & fname ){
+	this->close();
+	this->descriptor = ::open( fname.c_str(), O_RDONLY );
+	if( this->descriptor == -1 ){
+		return false;
+	}
+	struct stat status;
+	if( fstat( this->descriptor, &status ) != 0 ){
+		this->close();
+		return false;
+	}
+	//Pipes and devices have no size known in advance, they are read until their end
+	if( !S_ISREG( status.st_mode ) ){
+		const size_t chunk = 1 << 16;
+		ssize_t received;
+		do{
+			this->buffer.resize( this->_size + chunk );
+			received = read( this->descriptor, this->buffer.data() + this->_size, chunk );
+			if( received < 0 && errno == EINTR ){
+				continue;
+			}
+			if( received < 0 ){
+				this->close();
+				return false;
+			}
+			this->_size += received;
+		}while( received > 0 );
+		this->buffer.resize( this->_size );
+		this->_data = this->_size ? this->buffer.data() : NULL;
+		return true;
+	}
+	this->_size = status.st_size;
+	//Empty files can't be mapped, they are represented by empty range
+	if( this->_size == 0 ){
+		return true;
+	}
+	void * mapping = mmap( NULL, this->_size, PROT_READ, MAP_PRIVATE, this->descriptor, 0 );
+	if( mapping == MAP_FAILED ){
+		this->close();
+		return false;
+	}
+	madvise( mapping, this->_size, MADV_SEQUENTIAL );
+	this->_data = ( const char * )mapping;
+	return true;
+}
+
+/**
+	Method unmaps and closes the file.
+*/
+void MappedFile::close(){
+	if( this->_data != NULL && this->buffer.empty() ){
+		munmap( ( void * )this->_data, this->_size );
+	}
+	this->_data = NULL;
+	this->buffer.clear();
+	this->buffer.shrink_to_fit();
+	if( this->descriptor != -1 ){
+		::close( this->descriptor );
+		this->descriptor = -1;
+	}
+	this->_size = 0;
+}
+
+/**
+	@return Method returns pointer to the beginning of the mapped file.
+*/
+const char * MappedFile::data() const{
+	return this->_data;
+}
+
+/**
+	@return Method returns length of the mapped file.
+*/
+size_t MappedFile::size() const{
+	return this->_size;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file mapped_file.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class mapping files into memory.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+Class mapping whole file into memory for reading, so it can be parsed in place without copying it into buffers.
+Pipes and devices can't be mapped, they are read whole into a buffer owned by the object instead.
+ */
+class MappedFile
+{
+	int descriptor;			//**<Descriptor of the opened file, -1 if no file is opened
+	const char * _data;		//**<Beginning of the mapped file
+	size_t _size;			//**<Length of the mapped file
+	std::vector< char > buffer;	//**<Contents of the file which is not a regular file, empty if the file is mapped
+
+public:
+	/**
+		Constructor with no parameters.
+	*/
+	MappedFile();
+
+	/**
+		Destructor unmapping the file.
+	*/
+	~MappedFile();
+
+	MappedFile( const MappedFile & ) = delete;
+	MappedFile & operator=( const MappedFile & ) = delete;
+
+	/**
+		Method maps the file into memory, file which is not a regular file is read into the buffer.
+		@param fname Name of the file.
+		@return Method returns true if the file has been mapped or read, false if it couldn't be opened.
+	*/
+	bool open( const std::string & fname );
+
+	/**
+		Method unmaps and closes the file.
+	*/
+	void close();
+
+	/**
+		@return Method returns pointer to the beginning of the mapped file.
+	*/
+	const char * data() const;
+
+	/**
+		@return Method returns length of the mapped file.
+	*/
+	size_t size() const;
+};
+
+#endif
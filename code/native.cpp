@@ -0,0 +1,226 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include "native.h"
+
+//Number of gates emitted into a single function, huge functions take the compiler very long to optimize
+static const uint32_t gates_per_function = 4096;
+
+/**
+	Function computes 64-bit FNV-1a hash of the text.
+	@param text Hashed text.
+	@return Function returns hexadecimal representation of the hash.
+*/
+static std::string hash( const std::string & text ){
+	uint64_t hash = 14695981039346656037ull;
+	for( unsigned char c : text ){
+		hash = ( hash ^ c ) * 1099511628211ull;
+	}
+	char buffer[ 17 ];
+	snprintf( buffer, sizeof( buffer ), "%016llx", ( unsigned long long )hash );
+	return buffer;
+}
+
+/**
+	Constructor with no parameters.
+*/
+NativeNetlist::NativeNetlist(){
+	this->library = NULL;
+	this->_function = NULL;
+}
+
+/**
+	Destructor unloading the library.
+*/
+NativeNetlist::~NativeNetlist(){
+	if( this->library != NULL ){
+		dlclose( this->library );
+	}
+}
+
+/**
+	Function emits C++ source evaluating the netlist.
+	@param netlist Netlist to be emitted.
+	@param words Number of 64-bit words holding values of every node.
+	@return Function returns source of the library.
+*/
+std::string NativeNetlist::generate( const Netlist & netlist, int words ){
+	std::ostringstream source;
+	source<<"#include <stdint.h>\n";
+	source<<"#define W "<<words<<"\n";
+	source<<"#define V(node) v[ (node) * W + w ]\n";
+	//Lookup tables reduce their truth table one input at a time, calls with constant table and count are unrolled by the compiler
+	source<<"static inline uint64_t lut( uint64_t table, int count, const uint64_t * x ){\n";
+	source<<"uint64_t e[ 64 ];\n";
+	source<<"for( int i = 0; i < 1 << count; i++ ) e[i] = -( ( table >> i ) & 1 );\n";
+	source<<"for( int j = 0; j < count; j++ ) for( int i = 0; i < 1 << ( count - j - 1 ); i++ ) e[i] = e[ 2 * i ] ^ ( ( e[ 2 * i ] ^ e[ 2 * i + 1 ] ) & x[j] );\n";
+	source<<"return e[0];\n}\n";
+	uint32_t part = 0;
+	for( uint32_t first = netlist.input_count; first < netlist.size(); first += gates_per_function, part++ ){
+		source<<"static void part"<<part<<"( uint64_t * __restrict v ){\n";
+		source<<"for( int w = 0; w < W; w++ ){\n";
+		for( uint32_t node = first; node < netlist.size() && node < first + gates_per_function; node++ ){
+			uint32_t a = netlist.inputs1[ node ];
+			uint32_t b = netlist.inputs2[ node ];
+			uint8_t operation = netlist.operations[ node ];
+			uint32_t count = netlist.fanin_count( node );
+			if( operation == OPERATION_LUT ){
+				source<<"{const uint64_t x[]={";
+				for( uint32_t i = 0; i < count; i++ ){
+					source<<( i ? ",V(" : "V(" )<<netlist.input( node, i )<<")";
+				}
+				source<<"};V("<<node<<")=lut("<<netlist.tables[ node ]<<"ull,"<<count<<",x);}\n";
+				continue;
+			}
+			if( operation == OPERATION_DFF ){
+				//Flip-flops keep their values during the sweep, they are updated between clock cycles
+				continue;
+			}
+			if( operation == OPERATION_LATCH ){
+				source<<"V("<<node<<")=V("<<node<<")^((V("<<node<<")^V("<<b<<"))&V("<<a<<"));\n";
+				continue;
+			}
+			if( operation == OPERATION_MUX ){
+				uint32_t c = netlist.input( node, 2 );
+				source<<"V("<<node<<")=V("<<b<<")^((V("<<b<<")^V("<<c<<"))&V("<<a<<"));\n";
+				continue;
+			}
+			if( count > 2 ){
+				//Wide gates are emitted as a single expression over all inputs
+				bool negated;
+				uint8_t base = base_operation( operation, negated );
+				const char * symbol = base == OPERATION_AND ? "&" : base == OPERATION_OR ? "|" : "^";
+				source<<"V("<<node<<")="<<( negated ? "~(" : "(" );
+				for( uint32_t i = 0; i < count; i++ ){
+					source<<( i ? symbol : "" )<<"V("<<netlist.input( node, i )<<")";
+				}
+				source<<");\n";
+				continue;
+			}
+			source<<"V("<<node<<")=";
+			switch( operation ){
+				case OPERATION_NEG:
+					source<<"~V("<<a<<")";
+					break;
+				case OPERATION_AND:
+					source<<"V("<<a<<")&V("<<b<<")";
+					break;
+				case OPERATION_NAND:
+					source<<"~(V("<<a<<")&V("<<b<<"))";
+					break;
+				case OPERATION_OR:
+					source<<"V("<<a<<")|V("<<b<<")";
+					break;
+				case OPERATION_NOR:
+					source<<"~(V("<<a<<")|V("<<b<<"))";
+					break;
+				case OPERATION_XOR:
+					source<<"V("<<a<<")^V("<<b<<")";
+					break;
+				case OPERATION_XNOR:
+					source<<"~(V("<<a<<")^V("<<b<<"))";
+					break;
+				case OPERATION_ZERO:
+					source<<"0";
+					break;
+				case OPERATION_ONE:
+					source<<"~(uint64_t)0";
+					break;
+				default:
+					source<<"V("<<a<<")";
+					break;
+			}
+			source<<";\n";
+		}
+		source<<"}\n}\n";
+	}
+	source<<"extern \"C\" void dlsim_evaluate( uint64_t * v ){\n";
+	for( uint32_t i = 0; i < part; i++ ){
+		source<<"part"<<i<<"( v );\n";
+	}
+	source<<"}\n";
+	return source.str();
+}
+
+/**
+	Method compiles the netlist, or takes it from the cache, and loads it.
+	@param netlist Netlist to be compiled.
+	@param words Number of 64-bit words holding values of every node.
+	@return Method returns empty string on success, otherwise returns an error message.
+*/
+std::string NativeNetlist::load( const Netlist & netlist, int words ){
+	const char * compiler = getenv( "CXX" );
+	std::string command = std::string( compiler != NULL ? compiler : "c++" ) + " -O2 -march=native -shared -fPIC";
+	std::string source = NativeNetlist::generate( netlist, words );
+
+	std::filesystem::path directory;
+	if( getenv( "DLSIM_CACHE" ) != NULL ){
+		directory = getenv( "DLSIM_CACHE" );
+	}else if( getenv( "HOME" ) != NULL ){
+		directory = std::filesystem::path( getenv( "HOME" ) ) / ".cache" / "dlsim";
+	}else{
+		directory = std::filesystem::temp_directory_path() / "dlsim";
+	}
+	std::error_code error;
+	std::filesystem::create_directories( directory, error );
+	if( error ){
+		return "error: Couldn't create cache directory: " + directory.string();
+	}
+
+	//Compiler command is part of the key, so changing flags or compiler doesn't reuse stale libraries
+	std::string key = hash( command + "\n" + source );
+	std::filesystem::path library = directory / ( key + ".so" );
+	if( !std::filesystem::exists( library ) ){
+		std::string unique = key + "." + std::to_string( getpid() );
+		std::filesystem::path source_file = directory / ( unique + ".cpp" );
+		std::filesystem::path temporary = directory / ( unique + ".so" );
+		{
+			std::ofstream file( source_file );
+			if( !file ){
+				return "error: Couldn't write generated source: " + source_file.string();
+			}
+			file<<source;
+		}
+		command += " -o '" + temporary.string() + "' '" + source_file.string() + "'";
+		int status = std::system( command.c_str() );
+		std::filesystem::remove( source_file, error );
+		if( status != 0 ){
+			std::filesystem::remove( temporary, error );
+			return "error: Compilation of the circuit failed: " + command;
+		}
+		//Renaming is atomic, so concurrent runs never load partially written library
+		std::filesystem::rename( temporary, library, error );
+		if( error ){
+			return "error: Couldn't store compiled circuit in cache: " + library.string();
+		}
+	}
+
+	void * handle = dlopen( library.c_str(), RTLD_NOW | RTLD_LOCAL );
+	if( handle == NULL ){
+		return std::string( "error: Couldn't load compiled circuit: " ) + dlerror();
+	}
+	native_function function = ( native_function )dlsym( handle, "dlsim_evaluate" );
+	if( function == NULL ){
+		dlclose( handle );
+		return "error: Compiled circuit has no evaluating function: " + library.string();
+	}
+	if( this->library != NULL ){
+		dlclose( this->library );
+	}
+	this->library = handle;
+	this->_function = function;
+	return "";
+}
+
+/**
+	@return Method returns compiled function or NULL if nothing has been loaded.
+*/
+NativeNetlist::native_function NativeNetlist::function() const{
+	return this->_function;
+}
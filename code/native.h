@@ -0,0 +1,70 @@
+/**
+ * @file native.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class compiling netlist to native code.
+ */
+
+#ifndef NATIVE_H
+#define NATIVE_H
+
+#include <cstdint>
+#include <string>
+
+#include "netlist.h"
+
+/**
+Class compiling netlist to native code.
+The netlist is emitted as C++ source with one bitwise statement per gate, compiled into a shared library by the installed compiler and loaded with dlopen.
+Compiled libraries are cached on disk under the hash of their source, so every netlist is compiled only once.
+The compiler is taken from CXX environment variable (default c++), the cache directory from DLSIM_CACHE (default ~/.cache/dlsim).
+ */
+class NativeNetlist
+{
+public:
+	/**
+		Type of the compiled function, it evaluates the netlist on array of values holding words words per node.
+	*/
+	typedef void ( *native_function )( uint64_t * values );
+
+private:
+	void * library;					//**<Handle of the loaded library, NULL if nothing is loaded
+	native_function _function;		//**<Compiled function evaluating the netlist
+
+public:
+	/**
+		Constructor with no parameters.
+	*/
+	NativeNetlist();
+
+	/**
+		Destructor unloading the library.
+	*/
+	~NativeNetlist();
+
+	NativeNetlist( const NativeNetlist & ) = delete;
+	NativeNetlist & operator=( const NativeNetlist & ) = delete;
+
+	/**
+		Function emits C++ source evaluating the netlist.
+		@param netlist Netlist to be emitted.
+		@param words Number of 64-bit words holding values of every node.
+		@return Function returns source of the library.
+	*/
+	static std::string generate( const Netlist & netlist, int words );
+
+	/**
+		Method compiles the netlist, or takes it from the cache, and loads it.
+		@param netlist Netlist to be compiled.
+		@param words Number of 64-bit words holding values of every node.
+		@return Method returns empty string on success, otherwise returns an error message.
+	*/
+	std::string load( const Netlist & netlist, int words );
+
+	/**
+		@return Method returns compiled function or NULL if nothing has been loaded.
+	*/
+	native_function function() const;
+};
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file netlist.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of the compiled, levelized form of the circuit.
+ */
+
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "gate.h"
+
+/**
+A structure holding levelized circuit as contiguous arrays indexed by dense node indices (structure of arrays).
+Nodes are renumbered in topological order: input nodes occupy indices [ 0, input_count ) and every other node is computed only from nodes with lower indices,
+so the whole circuit is evaluated by a single forward sweep from input_count to size().
+Flip-flops are the only exception: they are at level 0 and their input, sampled only between clock cycles, may have any index.
+Arrays of the inputs hold 0 for unused inputs and for the input nodes themselves.
+Inputs of wide gates, multiplexers and lookup tables beyond the first two are kept in separate fanin lists, so the common two-input gates stay compact.
+*/
+struct Netlist{
+	std::vector< uint8_t > operations;/**< Operation computing every node, one of Operation values*/
+	std::vector< uint32_t > inputs1;/**< Index of the first input of every node*/
+	std::vector< uint32_t > inputs2;/**< Index of the second input of every node*/
+	std::vector< uint32_t > fanin_offsets = std::vector< uint32_t >( 1, 0 );/**< Further inputs of node i are stored in fanins[ fanin_offsets[i] ] to fanins[ fanin_offsets[i + 1] ]*/
+	std::vector< uint32_t > fanins;/**< Indices of the inputs beyond the second one, grouped by node*/
+	std::vector< uint64_t > tables;/**< Truth table of every lookup table node, 0 for other nodes*/
+	std::vector< int > nodes;/**< Side table connecting dense indices back to numbers of nodes from the circuit file*/
+	std::vector< uint32_t > levels;/**< Level of every node, input nodes are at level 0 and every gate is one level above its deepest input*/
+	std::vector< uint32_t > fanout_offsets;/**< Fanouts of node i are stored in fanouts[ fanout_offsets[i] ] to fanouts[ fanout_offsets[i + 1] ]*/
+	std::vector< uint32_t > fanouts;/**< Indices of nodes driven by every node, grouped by driving node*/
+	uint32_t input_count = 0;/**< Number of input nodes*/
+
+	/**
+		@return Function returns number of nodes in the netlist.
+	*/
+	uint32_t size() const{
+		return this->operations.size();
+	}
+
+	/**
+		@return Function returns level of the deepest node.
+	*/
+	uint32_t depth() const{
+		return this->levels.empty() ? 0 : *std::max_element( this->levels.begin(), this->levels.end() );
+	}
+
+	/**
+		@param node Index of the node.
+		@return Function returns number of inputs of the node.
+	*/
+	uint32_t fanin_count( uint32_t node ) const{
+		return operation_inputs( this->operations[ node ] ) + this->fanin_offsets[ node + 1 ] - this->fanin_offsets[ node ];
+	}
+
+	/**
+		@param node Index of the node.
+		@param i Position of the input, less than fanin_count( node ).
+		@return Function returns index of the input of the node.
+	*/
+	uint32_t input( uint32_t node, uint32_t i ) const{
+		return i == 0 ? this->inputs1[ node ] : i == 1 ? this->inputs2[ node ] : this->fanins[ this->fanin_offsets[ node ] + i - 2 ];
+	}
+
+	/**
+		Function appends node, its first two inputs are stored in inputs1 and inputs2 and the rest in the fanin list.
+		@param operation Operation computing the node.
+		@param inputs Indices of the inputs of the node.
+		@param table Truth table of lookup table, 0 for other operations.
+		@param id Number of the node from the circuit file.
+		@param level Level of the node.
+		@return Function returns index of the node.
+	*/
+	uint32_t add( uint8_t operation, const std::vector< uint32_t > & inputs, uint64_t table, int id, uint32_t level ){
+		this->operations.push_back( operation );
+		this->inputs1.push_back( inputs.size() >= 1 ? inputs[0] : 0 );
+		this->inputs2.push_back( inputs.size() >= 2 ? inputs[1] : 0 );
+		if( inputs.size() > 2 ){
+			this->fanins.insert( this->fanins.end(), inputs.begin() + 2, inputs.end() );
+		}
+		this->fanin_offsets.push_back( this->fanins.size() );
+		this->tables.push_back( table );
+		this->nodes.push_back( id );
+		this->levels.push_back( level );
+		return this->size() - 1;
+	}
+
+	/**	Function elaborates values of a node from values of its inputs, every bit of the word is a separate input vector.
+		Flip-flops keep their value, latches take their previous value from the node itself.
+		@param node Index of the node, it must not be an input node.
+		@param values Values of all nodes, indexed by node.
+		@return Function returns logic values of the node.
+	*/
+	template< typename Word >
+	Word evaluate( uint32_t node, const Word * values ) const{
+		uint8_t operation = this->operations[ node ];
+		const Word & input1 = values[ this->inputs1[ node ] ];
+		const Word & input2 = values[ this->inputs2[ node ] ];
+		uint32_t first = this->fanin_offsets[ node ];
+		uint32_t last = this->fanin_offsets[ node + 1 ];
+		if( first == last && operation <= OPERATION_ONE ){
+			return evaluate_operation( operation, input1, input2 );
+		}
+		if( operation == OPERATION_DFF ){
+			return values[ node ];
+		}
+		if( operation == OPERATION_LATCH ){
+			return evaluate_mux( input1, values[ node ], input2 );
+		}
+		if( operation == OPERATION_MUX ){
+			return evaluate_mux( input1, input2, values[ this->fanins[ first ] ] );
+		}
+		if( operation == OPERATION_LUT ){
+			Word inputs[ lut_max_inputs ] = { input1, input2 };
+			for( uint32_t i = first; i < last; i++ ){
+				inputs[ 2 + i - first ] = values[ this->fanins[i] ];
+			}
+			return evaluate_lut( this->tables[ node ], inputs, 2 + last - first );
+		}
+		//Wide gates fold all inputs with their base operation and negate the result at the end
+		bool negated;
+		uint8_t base = base_operation( operation, negated );
+		Word value = evaluate_operation( base, input1, input2 );
+		for( uint32_t i = first; i < last; i++ ){
+			value = evaluate_operation( base, value, values[ this->fanins[i] ] );
+		}
+		return negated ? Word( ~value ) : value;
+	}
+
+	/**
+		Function collects nodes the given nodes depend on, inputs of flip-flops are followed too.
+		Marks let the caller reuse one array for many cones, as nodes already marked with the stamp are skipped.
+		@param roots Indices of the nodes.
+		@param [in,out] marks Mark of every node, sized to the netlist, collected nodes are marked with the stamp.
+		@param stamp Mark of the collected nodes.
+		@param [out] nodes Collected nodes, the roots and every node in their input cones which was not marked with the stamp before.
+	*/
+	void cone( const std::vector< uint32_t > & roots, std::vector< uint32_t > & marks, uint32_t stamp, std::vector< uint32_t > & nodes ) const{
+		nodes.clear();
+		for( uint32_t root : roots ){
+			if( marks[ root ] != stamp ){
+				marks[ root ] = stamp;
+				nodes.push_back( root );
+			}
+		}
+		//Collected nodes double as the stack of the search
+		for( size_t next = 0; next < nodes.size(); next++ ){
+			uint32_t node = nodes[ next ];
+			for( uint32_t i = 0; node >= this->input_count && i < this->fanin_count( node ); i++ ){
+				uint32_t input = this->input( node, i );
+				if( marks[ input ] != stamp ){
+					marks[ input ] = stamp;
+					nodes.push_back( input );
+				}
+			}
+		}
+	}
+
+	/**
+		Function fills fanout lists from the inputs of the nodes, node is listed once even if it drives several inputs of the same gate.
+		Inputs of flip-flops are left out, as they don't propagate within a clock cycle.
+	*/
+	void build_fanouts(){
+		auto repeated = [ this ]( uint32_t node, uint32_t i ){
+			for( uint32_t j = 0; j < i; j++ ){
+				if( this->input( node, j ) == this->input( node, i ) ){
+					return true;
+				}
+			}
+			return false;
+		};
+		this->fanout_offsets.assign( this->size() + 1, 0 );
+		for( uint32_t node = this->input_count; node < this->size(); node++ ){
+			for( uint32_t i = 0; i < this->fanin_count( node ) && this->operations[ node ] != OPERATION_DFF; i++ ){
+				if( !repeated( node, i ) ){
+					this->fanout_offsets[ this->input( node, i ) + 1 ]++;
+				}
+			}
+		}
+		for( uint32_t node = 0; node < this->size(); node++ ){
+			this->fanout_offsets[ node + 1 ] += this->fanout_offsets[ node ];
+		}
+		this->fanouts.resize( this->fanout_offsets.back() );
+		std::vector< uint32_t > position( this->fanout_offsets.begin(), this->fanout_offsets.end() - 1 );
+		for( uint32_t node = this->input_count; node < this->size(); node++ ){
+			for( uint32_t i = 0; i < this->fanin_count( node ) && this->operations[ node ] != OPERATION_DFF; i++ ){
+				if( !repeated( node, i ) ){
+					this->fanouts[ position[ this->input( node, i ) ]++ ] = node;
+				}
+			}
+		}
+	}
+
+	/**
+		Function removes all nodes.
+	*/
+	void clear(){
+		this->operations.clear();
+		this->inputs1.clear();
+		this->inputs2.clear();
+		this->fanin_offsets.assign( 1, 0 );
+		this->fanins.clear();
+		this->tables.clear();
+		this->nodes.clear();
+		this->levels.clear();
+		this->fanout_offsets.clear();
+		this->fanouts.clear();
+		this->input_count = 0;
+	}
+};
+
+#endif
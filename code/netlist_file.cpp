@@ -0,0 +1,208 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "mapped_file.h"
+#include "netlist_file.h"
+
+static const char magic[] = { 'D', 'L', 'S', 'B' };
+static const size_t header_size = 40;
+
+/**
+	Function writes array padded with zeros to a multiple of 8 bytes.
+	@param file Stream the array is written to.
+	@param values Written array.
+*/
+template< typename T >
+static void write_array( std::ostream & file, const std::vector< T > & values ){
+	static const char padding[ 8 ] = {};
+	size_t size = values.size() * sizeof( T );
+	file.write( ( const char * )values.data(), size );
+	file.write( padding, ( 8 - size % 8 ) % 8 );
+}
+
+/**
+	Function copies array from the mapped file.
+	@param [in,out] position Position of the array, moved behind its padding.
+	@param end End of the mapped file.
+	@param count Number of elements.
+	@param [out] values Copied array.
+	@return Function returns false if the file is too short.
+*/
+template< typename T >
+static bool read_array( const char * & position, const char * end, size_t count, std::vector< T > & values ){
+	size_t size = count * sizeof( T );
+	if( size_t( end - position ) < size ){
+		return false;
+	}
+	values.resize( count );
+	memcpy( values.data(), position, size );
+	position += std::min( size_t( end - position ), ( size + 7 ) / 8 * 8 );
+	return true;
+}
+
+/**
+	@param fname Name of the file.
+	@return Function returns true if the file starts with the magic of the snapshot format, pipes and devices are always read as text.
+*/
+bool NetlistFile::is_snapshot( const std::string & fname ){
+	//Reading the magic from a pipe would consume it before the text is parsed
+	std::error_code error;
+	if( !std::filesystem::is_regular_file( fname, error ) ){
+		return false;
+	}
+	std::ifstream file( fname, std::ios::binary );
+	char header[ sizeof( magic ) ];
+	return file.read( header, sizeof( header ) ) && memcmp( header, magic, sizeof( magic ) ) == 0;
+}
+
+/**
+	Function writes the snapshot.
+	@param fname Name of the file.
+	@param circuit Compiled circuit.
+	@return Function returns empty string on success, otherwise returns an error message.
+*/
+std::string NetlistFile::write( const std::string & fname, const CompiledCircuit & circuit ){
+	std::ofstream file( fname, std::ios::binary );
+	if( !file ){
+		return "error: Couldn't open snapshot file for writing!";
+	}
+	const Netlist & netlist = circuit.netlist;
+	uint32_t header[] = { NetlistFile::version, netlist.size(), netlist.input_count, uint32_t( netlist.fanouts.size() ),
+		uint32_t( circuit.input_nodes.size() ), uint32_t( circuit.output_nodes.size() ), uint32_t( netlist.fanins.size() ),
+		uint32_t( circuit.unconnected_nodes.size() ), 0 };
+	file.write( magic, sizeof( magic ) );
+	file.write( ( const char * )header, sizeof( header ) );
+	write_array( file, netlist.operations );
+	write_array( file, netlist.inputs1 );
+	write_array( file, netlist.inputs2 );
+	write_array( file, netlist.nodes );
+	write_array( file, netlist.levels );
+	write_array( file, netlist.fanout_offsets );
+	write_array( file, netlist.fanouts );
+	write_array( file, netlist.fanin_offsets );
+	write_array( file, netlist.fanins );
+	write_array( file, netlist.tables );
+	write_array( file, circuit.input_nodes );
+	write_array( file, circuit.input_indices );
+	write_array( file, circuit.output_nodes );
+	write_array( file, circuit.output_indices );
+	write_array( file, circuit.unconnected_nodes );
+	file.close();
+	if( !file ){
+		return "error: Couldn't write snapshot file!";
+	}
+	return "";
+}
+
+/**
+	Function loads the snapshot and checks its consistency.
+	@param fname Name of the file.
+	@param [out] circuit Compiled circuit.
+	@return Function returns empty string on success, otherwise returns an error message.
+*/
+std::string NetlistFile::read( const std::string & fname, CompiledCircuit & circuit ){
+	MappedFile file;
+	if( !file.open( fname ) ){
+		return "error: Couldn't open circuit file for reading!";
+	}
+	if( file.size() < header_size || memcmp( file.data(), magic, sizeof( magic ) ) != 0 ){
+		return fname + ": error: not a circuit snapshot";
+	}
+	uint32_t header[ 8 ];
+	memcpy( header, file.data() + sizeof( magic ), sizeof( header ) );
+	if( header[0] != NetlistFile::version ){
+		return fname + ": error: unsupported version of circuit snapshot: " + std::to_string( header[0] );
+	}
+	uint32_t node_count = header[1];
+	uint32_t fanout_count = header[3];
+	uint32_t input_columns = header[4];
+	uint32_t output_columns = header[5];
+	uint32_t fanin_count = header[6];
+	uint32_t unconnected_count = header[7];
+
+	Netlist & netlist = circuit.netlist;
+	netlist.input_count = header[2];
+	const char * position = file.data() + header_size;
+	const char * end = file.data() + file.size();
+	if( !read_array( position, end, node_count, netlist.operations ) ||
+		!read_array( position, end, node_count, netlist.inputs1 ) ||
+		!read_array( position, end, node_count, netlist.inputs2 ) ||
+		!read_array( position, end, node_count, netlist.nodes ) ||
+		!read_array( position, end, node_count, netlist.levels ) ||
+		!read_array( position, end, size_t( node_count ) + 1, netlist.fanout_offsets ) ||
+		!read_array( position, end, fanout_count, netlist.fanouts ) ||
+		!read_array( position, end, size_t( node_count ) + 1, netlist.fanin_offsets ) ||
+		!read_array( position, end, fanin_count, netlist.fanins ) ||
+		!read_array( position, end, node_count, netlist.tables ) ||
+		!read_array( position, end, input_columns, circuit.input_nodes ) ||
+		!read_array( position, end, input_columns, circuit.input_indices ) ||
+		!read_array( position, end, output_columns, circuit.output_nodes ) ||
+		!read_array( position, end, output_columns, circuit.output_indices ) ||
+		!read_array( position, end, unconnected_count, circuit.unconnected_nodes ) ){
+		return fname + ": error: circuit snapshot is shorter than declared in its header";
+	}
+
+	//Evaluation trusts the netlist, so every index is checked once here
+	std::string corrupted = fname + ": error: corrupted circuit snapshot";
+	if( netlist.input_count > node_count || netlist.fanout_offsets[ node_count ] != fanout_count ||
+		netlist.fanin_offsets[0] != 0 || netlist.fanin_offsets[ node_count ] != fanin_count ){
+		return corrupted;
+	}
+	for( uint32_t node = 0; node < node_count; node++ ){
+		if( netlist.fanout_offsets[ node ] > netlist.fanout_offsets[ node + 1 ] || netlist.fanin_offsets[ node ] > netlist.fanin_offsets[ node + 1 ] ){
+			return corrupted;
+		}
+	}
+	for( uint32_t node = 0; node < node_count; node++ ){
+		uint8_t operation = netlist.operations[ node ];
+		if( operation > OPERATION_LATCH || ( operation == OPERATION_IN ) != ( node < netlist.input_count ) || operation == OPERATION_OUT ){
+			return corrupted;
+		}
+		//Only gates with two inputs in their fields may have further ones, multiplexers have exactly three and latches two
+		uint32_t inputs = netlist.fanin_count( node );
+		if( ( operation_inputs( operation ) < 2 && inputs != uint32_t( operation_inputs( operation ) ) ) ||
+			( operation == OPERATION_MUX && inputs != 3 ) || ( operation == OPERATION_LUT && inputs > uint32_t( lut_max_inputs ) ) ||
+			( operation == OPERATION_LATCH && inputs != 2 ) ){
+			return corrupted;
+		}
+		//Input of flip-flop is sampled between clock cycles, so it may come from any node
+		uint32_t limit = operation == OPERATION_DFF ? node_count : node;
+		for( uint32_t i = 0; i < inputs; i++ ){
+			if( netlist.input( node, i ) >= limit ){
+				return corrupted;
+			}
+		}
+		//Events are grouped by levels, so every gate has to be one level above its deepest input, gates without inputs are at level 0 or at level 1 if optimized
+		uint32_t level = 0;
+		if( operation != OPERATION_IN && operation != OPERATION_DFF ){
+			for( uint32_t i = 0; i < inputs; i++ ){
+				level = std::max( level, netlist.levels[ netlist.input( node, i ) ] + 1 );
+			}
+			if( inputs == 0 && netlist.levels[ node ] == 1 ){
+				level = 1;
+			}
+		}
+		if( netlist.levels[ node ] != level ){
+			return corrupted;
+		}
+	}
+	//Fanouts have to list exactly the gates driven by every node
+	std::vector< uint32_t > fanout_offsets( netlist.fanout_offsets );
+	std::vector< uint32_t > fanouts( netlist.fanouts );
+	netlist.build_fanouts();
+	if( netlist.fanout_offsets != fanout_offsets || netlist.fanouts != fanouts ){
+		return corrupted;
+	}
+	for( int index : circuit.input_indices ){
+		if( index >= int( netlist.input_count ) || index < -1 ){
+			return corrupted;
+		}
+	}
+	for( int index : circuit.output_indices ){
+		if( index < 0 || uint32_t( index ) >= node_count ){
+			return corrupted;
+		}
+	}
+	return "";
+}
@@ -0,0 +1,70 @@
+/**
+ * @file netlist_file.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class storing compiled circuit in binary snapshot.
+ */
+
+#ifndef NETLIST_FILE_H
+#define NETLIST_FILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "netlist.h"
+
+/**
+Structure holding everything needed to evaluate a compiled circuit.
+*/
+struct CompiledCircuit{
+	Netlist netlist;/**< Levelized circuit*/
+	std::vector< int > input_nodes;/**< Numbers of input nodes in ascending order*/
+	std::vector< int > input_indices;/**< Indices of values of the input nodes, -1 if the input drives no output*/
+	std::vector< int > output_nodes;/**< Numbers of output nodes in ascending order*/
+	std::vector< int > output_indices;/**< Indices of values of the output nodes*/
+	std::vector< int > unconnected_nodes;/**< Numbers of gates of the circuit file which drive no output and are left out of the netlist, in ascending order*/
+};
+
+/**
+Class reading and writing binary snapshot of a compiled circuit, so it can be loaded without parsing and levelizing it again.
+
+Layout of the file, all numbers are little endian:
+	- magic "DLSB" and 32-bit version number,
+	- 32-bit numbers of nodes, input nodes of the netlist, fanouts, input columns, output columns, fanins and unconnected gates, padded to 40 bytes,
+	- arrays of the netlist: operations (8-bit), inputs1, inputs2, nodes, levels, fanout_offsets (number of nodes + 1 entries), fanouts,
+	  fanin_offsets (number of nodes + 1 entries), fanins (32-bit) and tables (64-bit),
+	- arrays of the columns: input_nodes, input_indices, output_nodes and output_indices (32-bit),
+	- array of the unconnected_nodes (32-bit).
+
+Every array is padded with zeros to a multiple of 8 bytes. The file is mapped into memory and the arrays are copied as they are.
+ */
+class NetlistFile
+{
+public:
+	static const uint32_t version = 3;	//**<Version of the format written by this program
+
+	/**
+		@param fname Name of the file.
+		@return Function returns true if the file starts with the magic of the snapshot format, pipes and devices are always read as text.
+	*/
+	static bool is_snapshot( const std::string & fname );
+
+	/**
+		Function writes the snapshot.
+		@param fname Name of the file.
+		@param circuit Compiled circuit.
+		@return Function returns empty string on success, otherwise returns an error message.
+	*/
+	static std::string write( const std::string & fname, const CompiledCircuit & circuit );
+
+	/**
+		Function loads the snapshot and checks its consistency.
+		@param fname Name of the file.
+		@param [out] circuit Compiled circuit.
+		@return Function returns empty string on success, otherwise returns an error message.
+	*/
+	static std::string read( const std::string & fname, CompiledCircuit & circuit );
+};
+
+#endif
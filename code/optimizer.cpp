@@ -0,0 +1,443 @@
+#include <algorithm>
+#include <climits>
+
+#include "optimizer.h"
+
+/**
+	Function inserts bit into the number, bits from the position up move one place higher.
+	@param number Number the bit is inserted into.
+	@param position Position of the inserted bit.
+	@param bit Inserted bit, 0 or 1.
+	@return Function returns the extended number.
+*/
+static uint64_t insert_bit( uint64_t number, int position, uint64_t bit ){
+	uint64_t low = number & ( ( uint64_t( 1 ) << position ) - 1 );
+	return ( number - low ) << 1 | bit << position | low;
+}
+
+/**
+	Function removes input from the truth table by fixing its value.
+	@param table Truth table.
+	@param count Number of inputs of the table.
+	@param input Removed input.
+	@param value Value of the removed input.
+	@return Function returns truth table of the remaining inputs.
+*/
+static uint64_t cofactor( uint64_t table, int count, int input, bool value ){
+	uint64_t result = 0;
+	for( uint64_t entry = 0; entry < uint64_t( 1 ) << ( count - 1 ); entry++ ){
+		result |= ( table >> insert_bit( entry, input, value ) & 1 ) << entry;
+	}
+	return result;
+}
+
+/**
+	Function removes input from the truth table, which is connected to the same signal as another input with lower position.
+	@param table Truth table.
+	@param count Number of inputs of the table.
+	@param input Removed input.
+	@param same Position of the input connected to the same signal, lower than input.
+	@return Function returns truth table of the remaining inputs.
+*/
+static uint64_t merge( uint64_t table, int count, int input, int same ){
+	uint64_t result = 0;
+	for( uint64_t entry = 0; entry < uint64_t( 1 ) << ( count - 1 ); entry++ ){
+		result |= ( table >> insert_bit( entry, input, ( entry >> same ) & 1 ) & 1 ) << entry;
+	}
+	return result;
+}
+
+/**
+	Function negates input of the truth table.
+	@param table Truth table.
+	@param count Number of inputs of the table.
+	@param input Negated input.
+	@return Function returns truth table with the input negated.
+*/
+static uint64_t flip( uint64_t table, int count, int input ){
+	uint64_t result = 0;
+	for( uint64_t entry = 0; entry < uint64_t( 1 ) << count; entry++ ){
+		result |= ( table >> ( entry ^ ( uint64_t( 1 ) << input ) ) & 1 ) << entry;
+	}
+	return result;
+}
+
+/**
+	Constructor preparing optimization of the netlist.
+	@param source Netlist to be optimized.
+*/
+Optimizer::Optimizer( const Netlist & source ) : source( source ){
+	this->zero = UINT32_MAX;
+}
+
+/** Method adds node to the result, reusing existing node with the same structure.
+	@param operation Operation of the node.
+	@param input1 Index of the first input.
+	@param input2 Index of the second input.
+	@param id Number of the node from the circuit file, -1 for nodes created by the optimization.
+	@return Method returns index of the node.
+*/
+uint32_t Optimizer::add( uint8_t operation, uint32_t input1, uint32_t input2, int id ){
+	Structure structure = { operation, input1, input2 };
+	auto found = this->structures.find( structure );
+	if( found != this->structures.end() ){
+		if( this->result.nodes[ found->second ] == -1 ){
+			this->result.nodes[ found->second ] = id;
+		}
+		return found->second;
+	}
+	this->fanin.clear();
+	if( operation_inputs( operation ) >= 1 ){
+		this->fanin.push_back( input1 );
+	}
+	if( operation_inputs( operation ) >= 2 ){
+		this->fanin.push_back( input2 );
+	}
+	uint32_t index = this->result.add( operation, this->fanin, 0, id, 0 );
+	this->structures[ structure ] = index;
+	return index;
+}
+
+/** Method adds wide gate, multiplexer or lookup table to the result, these nodes are not merged.
+	@param operation Operation of the node.
+	@param inputs Indices of the inputs.
+	@param table Truth table of lookup table, 0 for other operations.
+	@param id Number of the node from the circuit file, -1 for nodes created by the optimization.
+	@return Method returns index of the node.
+*/
+uint32_t Optimizer::add_wide( uint8_t operation, const std::vector< uint32_t > & inputs, uint64_t table, int id ){
+	return this->result.add( operation, inputs, table, id, 0 );
+}
+
+/**
+	@param value Value of the constant.
+	@return Method returns literal of the constant.
+*/
+uint32_t Optimizer::constant( bool value ){
+	if( this->zero == UINT32_MAX ){
+		this->zero = this->add( OPERATION_ZERO, 0, 0, -1 );
+	}
+	return this->zero * 2 + value;
+}
+
+/**
+	@param literal Checked literal.
+	@return Method returns true if the literal is a constant.
+*/
+bool Optimizer::is_constant( uint32_t literal ) const{
+	return literal / 2 == this->zero;
+}
+
+/** Method creates node holding value of the literal.
+	@param literal Literal to be materialized.
+	@param id Number of the node from the circuit file, -1 for nodes created by the optimization.
+	@return Method returns index of the node.
+*/
+uint32_t Optimizer::materialize( uint32_t literal, int id ){
+	if( literal % 2 == 0 ){
+		return literal / 2;
+	}
+	if( this->is_constant( literal ) ){
+		return this->add( OPERATION_ONE, 0, 0, id );
+	}
+	return this->add( OPERATION_NEG, literal / 2, 0, id );
+}
+
+/** Method creates literal of AND, OR or XOR of the literals, folding constant, equal and complementary inputs.
+	@param base OPERATION_AND, OPERATION_OR or OPERATION_XOR.
+	@param [in,out] literals Literals of the inputs, they are reordered.
+	@param id Number of the node from the circuit file, given to the created node if it holds the value of the literal without negation.
+	@return Method returns literal of the result.
+*/
+uint32_t Optimizer::gate( uint8_t base, std::vector< uint32_t > & literals, int id ){
+	uint32_t negated = 0;
+	size_t kept = 0;
+	for( uint32_t literal : literals ){
+		if( base == OPERATION_XOR ){
+			//Negations of xor inputs move to its output, constants only negate it
+			negated ^= literal & 1;
+			literal &= ~1u;
+			if( this->is_constant( literal ) ){
+				continue;
+			}
+		}else if( this->is_constant( literal ) ){
+			//Constant 0 decides result of AND alone and constant 1 result of OR, the other constant is ignored
+			if( ( literal & 1 ) == ( base == OPERATION_OR ) ){
+				return literal;
+			}
+			continue;
+		}
+		literals[ kept++ ] = literal;
+	}
+	literals.resize( kept );
+
+	//Inputs are sorted, so commutative gates with swapped inputs get the same structure and equal inputs are adjacent
+	std::sort( literals.begin(), literals.end() );
+	kept = 0;
+	for( size_t i = 0; i < literals.size(); i++ ){
+		if( kept && literals[ kept - 1 ] == literals[i] ){
+			if( base == OPERATION_XOR ){
+				kept--;
+			}
+			continue;
+		}
+		if( kept && ( literals[ kept - 1 ] ^ 1 ) == literals[i] ){
+			return this->constant( base == OPERATION_OR );
+		}
+		literals[ kept++ ] = literals[i];
+	}
+	literals.resize( kept );
+
+	if( literals.empty() ){
+		return this->constant( base == OPERATION_AND ) ^ negated;
+	}
+	if( literals.size() == 1 ){
+		return literals[0] ^ negated;
+	}
+	id = negated ? -1 : id;
+	if( literals.size() == 2 ){
+		uint32_t input1 = this->materialize( literals[0], -1 );
+		uint32_t input2 = this->materialize( literals[1], -1 );
+		return this->add( base, input1, input2, id ) * 2 ^ negated;
+	}
+	std::vector< uint32_t > inputs;
+	for( uint32_t literal : literals ){
+		inputs.push_back( this->materialize( literal, -1 ) );
+	}
+	return this->add_wide( base, inputs, 0, id ) * 2 ^ negated;
+}
+
+/** Method creates literal of multiplexer, reducing it to simpler gate when its inputs are constant or related.
+	@param select Literal of the selecting input.
+	@param input0 Literal of the input passed when select is 0.
+	@param input1 Literal of the input passed when select is 1.
+	@param id Number of the node from the circuit file, given to the created node if it holds the value of the literal without negation.
+	@return Method returns literal of the result.
+*/
+uint32_t Optimizer::mux( uint32_t select, uint32_t input0, uint32_t input1, int id ){
+	if( this->is_constant( select ) ){
+		return select & 1 ? input1 : input0;
+	}
+	//Negated select swaps the data inputs
+	if( select & 1 ){
+		select ^= 1;
+		std::swap( input0, input1 );
+	}
+	if( input0 == input1 ){
+		return input0;
+	}
+	std::vector< uint32_t > literals;
+	if( ( input0 ^ 1 ) == input1 ){
+		literals = { select, input0 };
+		return this->gate( OPERATION_XOR, literals, id );
+	}
+	//Data input constant or equal to the select leaves single AND or OR gate
+	bool constant0 = this->is_constant( input0 );
+	bool constant1 = this->is_constant( input1 );
+	if( ( constant0 && !( input0 & 1 ) ) || input0 == select ){
+		literals = { select, input1 };
+		return this->gate( OPERATION_AND, literals, id );
+	}
+	if( constant0 || input0 == ( select ^ 1 ) ){
+		literals = { select ^ 1, input1 };
+		return this->gate( OPERATION_OR, literals, id );
+	}
+	if( ( constant1 && !( input1 & 1 ) ) || input1 == ( select ^ 1 ) ){
+		literals = { select ^ 1, input0 };
+		return this->gate( OPERATION_AND, literals, id );
+	}
+	if( constant1 || input1 == select ){
+		literals = { select, input0 };
+		return this->gate( OPERATION_OR, literals, id );
+	}
+	//Negation of both data inputs moves to the output
+	uint32_t negated = input0 & input1 & 1;
+	std::vector< uint32_t > inputs = { select / 2, this->materialize( input0 ^ negated, -1 ), this->materialize( input1 ^ negated, -1 ) };
+	return this->add_wide( OPERATION_MUX, inputs, 0, negated ? -1 : id ) * 2 ^ negated;
+}
+
+/** Method creates literal of lookup table, removing constant, negated, repeated and unused inputs from its truth table.
+	@param table Truth table.
+	@param [in,out] literals Literals of the inputs, they are changed.
+	@param id Number of the node from the circuit file, given to the created node if it holds the value of the literal without negation.
+	@return Method returns literal of the result.
+*/
+uint32_t Optimizer::lut( uint64_t table, std::vector< uint32_t > & literals, int id ){
+	int count = literals.size();
+	for( int input = 0; input < count; input++ ){
+		uint32_t & literal = literals[ input ];
+		if( literal & 1 ){
+			table = flip( table, count, input );
+			literal ^= 1;
+		}
+		int same = std::find( literals.begin(), literals.begin() + input, literal ) - literals.begin();
+		bool removed = true;
+		if( this->is_constant( literal ) ){
+			table = cofactor( table, count, input, false );
+		}else if( same < input ){
+			table = merge( table, count, input, same );
+		}else{
+			removed = false;
+		}
+		if( removed ){
+			literals.erase( literals.begin() + input );
+			count--;
+			input--;
+		}
+	}
+	//Inputs the table doesn't depend on are removed once the others are distinct signals
+	for( int input = 0; input < count; input++ ){
+		if( cofactor( table, count, input, false ) == cofactor( table, count, input, true ) ){
+			table = cofactor( table, count, input, false );
+			literals.erase( literals.begin() + input );
+			count--;
+			input--;
+		}
+	}
+	if( count == 0 ){
+		return this->constant( table & 1 );
+	}
+	if( count == 1 ){
+		return literals[0] ^ ( table & 1 );
+	}
+
+	//Table is complemented to have 0 for all inputs 0, so tables differing only by output negation share the node
+	uint32_t negated = table & 1;
+	if( negated ){
+		table = ~table & ( count == lut_max_inputs ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( 1 << count ) ) - 1 );
+	}
+	id = negated ? -1 : id;
+	if( count == 2 ){
+		//Remaining two-input functions are AND with possibly negated inputs, OR and XOR
+		uint8_t base = table == 0xE ? OPERATION_OR : table == 0x6 ? OPERATION_XOR : OPERATION_AND;
+		if( table == 0x2 ){
+			literals[1] ^= 1;
+		}else if( table == 0x4 ){
+			literals[0] ^= 1;
+		}
+		return this->gate( base, literals, id ) ^ negated;
+	}
+	std::vector< uint32_t > inputs;
+	for( uint32_t literal : literals ){
+		inputs.push_back( literal / 2 );
+	}
+	return this->add_wide( OPERATION_LUT, inputs, table, id ) * 2 ^ negated;
+}
+
+/** Method builds optimized netlist, input nodes keep their indices.
+	@param [in,out] outputs Indices of nodes read as outputs, replaced by indices in the optimized netlist.
+	@return Method returns optimized netlist with levels and fanouts filled in.
+*/
+Netlist Optimizer::optimize( std::vector< int > & outputs ){
+	std::vector< uint32_t > literals( this->source.size() );
+	std::vector< uint32_t > inputs;
+	std::vector< uint32_t > registers;
+	for( uint32_t node = 0; node < this->source.size(); node++ ){
+		int id = this->source.nodes[ node ];
+		uint8_t operation = this->source.operations[ node ];
+		if( operation == OPERATION_IN ){
+			inputs.clear();
+			this->result.add( OPERATION_IN, inputs, 0, id, 0 );
+			this->result.input_count++;
+			literals[ node ] = node * 2;
+			continue;
+		}
+		if( operation == OPERATION_DFF ){
+			//Flip-flops are sources of the sweep, their inputs are connected once all nodes have literals
+			inputs.assign( 1, 0 );
+			literals[ node ] = this->add_wide( OPERATION_DFF, inputs, 0, id ) * 2;
+			registers.push_back( node );
+			continue;
+		}
+		if( operation == OPERATION_ZERO || operation == OPERATION_ONE ){
+			literals[ node ] = this->constant( operation == OPERATION_ONE );
+			continue;
+		}
+		uint32_t a = literals[ this->source.inputs1[ node ] ];
+		if( operation == OPERATION_NEG ){
+			literals[ node ] = a ^ 1;
+			continue;
+		}
+		if( operation == OPERATION_MUX ){
+			literals[ node ] = this->mux( a, literals[ this->source.inputs2[ node ] ], literals[ this->source.input( node, 2 ) ], id );
+			continue;
+		}
+		if( operation == OPERATION_LATCH ){
+			//Latch enabled all the time is transparent, latch never enabled keeps its initial 0
+			if( this->is_constant( a ) ){
+				literals[ node ] = a & 1 ? literals[ this->source.inputs2[ node ] ] : this->constant( false );
+				continue;
+			}
+			inputs = { this->materialize( a, -1 ), this->materialize( literals[ this->source.inputs2[ node ] ], -1 ) };
+			literals[ node ] = this->add_wide( OPERATION_LATCH, inputs, 0, id ) * 2;
+			continue;
+		}
+		inputs.clear();
+		for( uint32_t i = 0; i < this->source.fanin_count( node ); i++ ){
+			inputs.push_back( literals[ this->source.input( node, i ) ] );
+		}
+		if( operation == OPERATION_LUT ){
+			literals[ node ] = this->lut( this->source.tables[ node ], inputs, id );
+			continue;
+		}
+
+		//Normalizing to AND, OR and XOR with negated output
+		bool negated;
+		uint8_t base = base_operation( operation, negated );
+		literals[ node ] = this->gate( base, inputs, negated ? -1 : id ) ^ negated;
+	}
+	for( uint32_t node : registers ){
+		this->result.inputs1[ literals[ node ] / 2 ] = this->materialize( literals[ this->source.inputs1[ node ] ], -1 );
+	}
+	for( auto & output : outputs ){
+		output = this->materialize( literals[ output ], this->source.nodes[ output ] );
+	}
+
+	//Removing nodes which drive no output, input nodes are always kept, flip-flops keep the logic driving them
+	std::vector< bool > live( this->result.size() );
+	std::vector< uint32_t > stack( outputs.begin(), outputs.end() );
+	while( !stack.empty() ){
+		uint32_t node = stack.back();
+		stack.pop_back();
+		if( live[ node ] ){
+			continue;
+		}
+		live[ node ] = true;
+		for( uint32_t i = 0; i < this->result.fanin_count( node ); i++ ){
+			stack.push_back( this->result.input( node, i ) );
+		}
+	}
+	//Indices are assigned before the nodes are added, as inputs of flip-flops may follow them
+	Netlist netlist;
+	std::vector< uint32_t > indices( this->result.size() );
+	uint32_t count = 0;
+	for( uint32_t node = 0; node < this->result.size(); node++ ){
+		if( node < this->result.input_count || live[ node ] ){
+			indices[ node ] = count++;
+		}
+	}
+	for( uint32_t node = 0; node < this->result.size(); node++ ){
+		if( node >= this->result.input_count && !live[ node ] ){
+			continue;
+		}
+		inputs.clear();
+		uint32_t level = 0;
+		uint8_t operation = this->result.operations[ node ];
+		for( uint32_t i = 0; i < this->result.fanin_count( node ); i++ ){
+			inputs.push_back( indices[ this->result.input( node, i ) ] );
+			if( operation != OPERATION_DFF ){
+				level = std::max( level, netlist.levels[ inputs.back() ] + 1 );
+			}
+		}
+		if( operation != OPERATION_IN && operation != OPERATION_DFF ){
+			level = std::max( level, 1u );
+		}
+		netlist.add( operation, inputs, this->result.tables[ node ], this->result.nodes[ node ], level );
+	}
+	netlist.input_count = this->result.input_count;
+	for( auto & output : outputs ){
+		output = indices[ output ];
+	}
+	netlist.build_fanouts();
+	return netlist;
+}
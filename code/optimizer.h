@@ -0,0 +1,132 @@
+/**
+ * @file optimizer.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class optimizing levelized netlist.
+ */
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "netlist.h"
+
+/**
+Class rebuilding netlist without redundant logic.
+Signals are tracked as literals, index of a node times two plus a flag of negation, so chains of negations collapse without creating any gates.
+Gates are normalized to AND, OR and XOR with negated output, folded when their inputs are constant, equal or complementary,
+and merged with structurally identical gates found by hashing their operation and inputs. Finally gates which drive no output are removed.
+Wide gates, multiplexers and lookup tables are simplified the same way and become two-input gates when possible, those left wide are not merged.
+Flip-flops and latches are never merged, logic driving kept flip-flops is kept too.
+ */
+class Optimizer
+{
+	/**
+	Structure identifying gate by its operation and inputs.
+	*/
+	struct Structure{
+		uint8_t operation;/**< Operation of the gate*/
+		uint32_t input1;/**< Index of the first input*/
+		uint32_t input2;/**< Index of the second input*/
+
+		bool operator==( const Structure & other ) const{
+			return this->operation == other.operation && this->input1 == other.input1 && this->input2 == other.input2;
+		}
+	};
+
+	/**
+	Structure computing hash of the gate structure.
+	*/
+	struct StructureHash{
+		size_t operator()( const Structure & structure ) const{
+			uint64_t key = ( uint64_t( structure.input1 ) << 32 | structure.input2 ) * 0x9E3779B97F4A7C15ull;
+			return key ^ ( key >> 29 ) ^ structure.operation;
+		}
+	};
+
+	const Netlist & source;												//**<Netlist being optimized
+	Netlist result;														//**<Optimized netlist being built
+	std::unordered_map< Structure, uint32_t, StructureHash > structures;	//**<Map connecting structures of created gates to their indices
+	uint32_t zero;														//**<Index of constant 0 node, UINT32_MAX if it has not been created yet
+	std::vector< uint32_t > fanin;										//**<Inputs of the node being added, kept to avoid allocation for every node
+
+	/** Method adds node to the result, reusing existing node with the same structure.
+		@param operation Operation of the node.
+		@param input1 Index of the first input.
+		@param input2 Index of the second input.
+		@param id Number of the node from the circuit file, -1 for nodes created by the optimization.
+		@return Method returns index of the node.
+	*/
+	uint32_t add( uint8_t operation, uint32_t input1, uint32_t input2, int id );
+
+	/** Method adds wide gate, multiplexer or lookup table to the result, these nodes are not merged.
+		@param operation Operation of the node.
+		@param inputs Indices of the inputs.
+		@param table Truth table of lookup table, 0 for other operations.
+		@param id Number of the node from the circuit file, -1 for nodes created by the optimization.
+		@return Method returns index of the node.
+	*/
+	uint32_t add_wide( uint8_t operation, const std::vector< uint32_t > & inputs, uint64_t table, int id );
+
+	/** Method creates literal of AND, OR or XOR of the literals, folding constant, equal and complementary inputs.
+		@param base OPERATION_AND, OPERATION_OR or OPERATION_XOR.
+		@param [in,out] literals Literals of the inputs, they are reordered.
+		@param id Number of the node from the circuit file, given to the created node if it holds the value of the literal without negation.
+		@return Method returns literal of the result.
+	*/
+	uint32_t gate( uint8_t base, std::vector< uint32_t > & literals, int id );
+
+	/** Method creates literal of multiplexer, reducing it to simpler gate when its inputs are constant or related.
+		@param select Literal of the selecting input.
+		@param input0 Literal of the input passed when select is 0.
+		@param input1 Literal of the input passed when select is 1.
+		@param id Number of the node from the circuit file, given to the created node if it holds the value of the literal without negation.
+		@return Method returns literal of the result.
+	*/
+	uint32_t mux( uint32_t select, uint32_t input0, uint32_t input1, int id );
+
+	/** Method creates literal of lookup table, removing constant, negated, repeated and unused inputs from its truth table.
+		@param table Truth table.
+		@param [in,out] literals Literals of the inputs, they are changed.
+		@param id Number of the node from the circuit file, given to the created node if it holds the value of the literal without negation.
+		@return Method returns literal of the result.
+	*/
+	uint32_t lut( uint64_t table, std::vector< uint32_t > & literals, int id );
+
+	/** Method creates node holding value of the literal.
+		@param literal Literal to be materialized.
+		@param id Number of the node from the circuit file, -1 for nodes created by the optimization.
+		@return Method returns index of the node.
+	*/
+	uint32_t materialize( uint32_t literal, int id );
+
+	/**
+		@param value Value of the constant.
+		@return Method returns literal of the constant.
+	*/
+	uint32_t constant( bool value );
+
+	/**
+		@param literal Checked literal.
+		@return Method returns true if the literal is a constant.
+	*/
+	bool is_constant( uint32_t literal ) const;
+
+public:
+	/**
+		Constructor preparing optimization of the netlist.
+		@param source Netlist to be optimized.
+	*/
+	Optimizer( const Netlist & source );
+
+	/** Method builds optimized netlist, input nodes keep their indices.
+		@param [in,out] outputs Indices of nodes read as outputs, replaced by indices in the optimized netlist.
+		@return Method returns optimized netlist with levels and fanouts filled in.
+	*/
+	Netlist optimize( std::vector< int > & outputs );
+};
+
+#endif
@@ -1,20 +1,66 @@
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 
+#include "parse_options.h"
+
+/**
+	Function parses comma separated list of node numbers.
+	@param param Parsed list.
+	@param [out] nodes Numbers of the nodes.
+	@return Function returns false if the list is incorrect.
+*/
+static bool parse_nodes( const std::string & param, std::vector< int > & nodes ){
+	nodes.clear();
+	size_t begin = 0;
+	while( begin <= param.size() ){
+		size_t end = std::min( param.find( ',', begin ), param.size() );
+		std::string node = param.substr( begin, end - begin );
+		if( node.empty() || node.find_first_not_of( "0123456789" ) != std::string::npos || node.size() > 9 ){
+			return false;
+		}
+		nodes.push_back( std::stoi( node ) );
+		begin = end + 1;
+	}
+	return true;
+}
+
 /**
 	Function parses command line parameters and figures out input and output files
 	@param argv array of c strings containing command line parameters
 	@param argc length of argv 
-	@param [in,out] input_file name of file containing inputs
-	@param [in,out] circuit_file name of file containing circuit structure
-	@param [in,out] output_file name of file containing outputs
+	@param [in,out] options structure filled with the settings
 */
-std::string parse_options( int argc, char** argv, std::string & input_file,  
-	std::string & circuit_file, std::string & output_file ){
+std::string parse_options( int argc, char** argv, Options & options ){
 	
 	const std::string input_switch = "-i";
 	const std::string output_switch = "-o";
 	const std::string circuit_switch = "-u";
+	const std::string width_switch = "-w";
+	const std::string threads_switch = "-j";
+	const std::string testbenches_switch = "-k";
+	const std::string stream_switch = "-s";
+	const std::string binary_switch = "-b";
+	const std::string pack_switch = "-p";
+	const std::string event_switch = "-e";
+	const std::string four_valued_switch = "--four-valued";
+	const std::string native_switch = "-n";
+	const std::string optimize_switch = "-O";
+	const std::string exhaustive_switch = "-x";
+	const std::string equivalence_switch = "-q";
+	const std::string faults_switch = "--faults";
+	const std::string timing_switch = "--timing";
+	const std::string toggles_switch = "--toggles";
+	const std::string activity_switch = "--activity";
+	const std::string outputs_switch = "--outputs";
+	const std::string waveform_switch = "--vcd";
+	const std::string waveform_nodes_switch = "--vcd-nodes";
+	const std::string waveform_levels_switch = "--vcd-levels";
+	const std::string compile_switch = "--compile";
+	const std::string server_switch = "-d";
+	const std::string client_switch = "-c";
+	const std::string stats_switch = "--stats";
+	const std::string stats_file_switch = "--stats-json";
 	const std::string help_switch = "-h";
 	const std::string help_switch_long = "--help";
 	std::string executable = std::filesystem::path( argv[0] ).stem();
@@ -24,6 +70,31 @@ std::string parse_options( int argc, char** argv, std::string & input_file,
 	circuit_switch + " <file>\tRead circuit structure from <file>\n\t" +
 	input_switch + " <file>\tRead inputs from <file>\n\t" + 
 	output_switch + "<file> 	Place the outputs into <file>\n\t" +
+	width_switch + " <n>\tSimulate <n> input vectors in parallel, <n> is 64, 256 or 512 (default 64)\n\t" +
+	threads_switch + " <n>\tEvaluate input vectors on <n> threads (default 1)\n\t" +
+	testbenches_switch + " <n>\tSimulate sequential circuit as <n> independent testbenches, input vector i is clock cycle i / <n> of testbench i % <n> (default 1)\n\t" +
+	stream_switch + " <n>\tRead, evaluate and write input vectors in batches of <n> vectors\n\t" +
+	binary_switch + "\t\tWrite the outputs in packed binary format\n\t" +
+	optimize_switch + "\t\tRemove redundant logic from the circuit before simulation\n\t" +
+	native_switch + "\t\tCompile the circuit to native code with the installed compiler (CXX) and evaluate through it\n\t" +
+	event_switch + "\t\tEvaluate only gates affected by inputs changed since the previous vector\n\t" +
+	four_valued_switch + "\tSimulate values 0, 1, X and Z, inputs missing in a vector are X, flip-flops and latches start at X until they are set\n\t" +
+	outputs_switch + " <n,m,...>\tSimulate only the listed outputs, skipping logic outside of their input cones\n\t" +
+	exhaustive_switch + "\t\tSimulate every assignment of the inputs instead of reading them, writing the truth table\n\t" +
+	equivalence_switch + " <file>\tCompare outputs of the circuit with circuit from <file> for every assignment of the inputs\n\t" +
+	timing_switch + " <file>\tSimulate vectors one by one with delays of the gates from <file>, writing settle times of the outputs and depth of the longest path\n\t" +
+	toggles_switch + " <file>\tWrite number of toggles and glitches of every node of the timing simulation into <file>\n\t" +
+	activity_switch + " <file>\tWrite number of ones and toggles of every node and toggle coverage of bit-parallel simulation into <file>\n\t" +
+	waveform_switch + " <file>\tWrite values of the nodes of bit-parallel simulation into Value Change Dump <file>, compressed with gzip if <file> ends with .gz\n\t" +
+	waveform_nodes_switch + " <n,m,...>\tWrite only the listed nodes into the waveform\n\t" +
+	waveform_levels_switch + " <min>:<max>\tWrite only nodes with level from <min> to <max> into the waveform\n\t" +
+	faults_switch + "\tGrade the input vectors by stuck-at faults of every gate output, writing fault coverage and the first vector detecting each fault\n\t" +
+	compile_switch + " <file>\tBuild circuit from <file> and write its binary snapshot into the output file, snapshots are accepted by " + circuit_switch + "\n\t" +
+	server_switch + " <socket>\tRun as server on Unix <socket>, keeping built circuits between jobs\n\t" +
+	client_switch + " <socket>\tSend the job to the server listening on <socket>\n\t" +
+	stats_switch + "\t\tPrint time of the phases, work done and shape of the circuit\n\t" +
+	stats_file_switch + " <file>\tWrite the statistics into <file> in JSON format\n\t" +
+	pack_switch + " <file>\tPack inputs into binary <file> instead of simulating them\n\t" +
 	help_switch + "," + help_switch_long + "\tDisplay this message";
 	
 	std::string more_info = "Try " + executable + " --help for more information";
@@ -40,21 +111,95 @@ std::string parse_options( int argc, char** argv, std::string & input_file,
 			if(sw == help_switch || sw == help_switch_long){
 				return usage + "\n" + help + "\n";
 				
+			}else if( sw == binary_switch ){
+				options.binary_output = true;
+			}else if( sw == event_switch ){
+				options.event_driven = true;
+			}else if( sw == four_valued_switch ){
+				options.four_valued = true;
+			}else if( sw == native_switch ){
+				options.native = true;
+			}else if( sw == optimize_switch ){
+				options.optimize = true;
+			}else if( sw == exhaustive_switch ){
+				options.exhaustive = true;
+			}else if( sw == faults_switch ){
+				options.faults = true;
+			}else if( sw == stats_switch ){
+				options.stats = true;
 			}else{
-				if( sw != input_switch && sw != circuit_switch && sw != output_switch ){
+				if( sw != input_switch && sw != circuit_switch && sw != output_switch && sw != width_switch && sw != threads_switch && sw != testbenches_switch && sw != stream_switch && sw != pack_switch && sw != stats_file_switch && sw != server_switch && sw != client_switch && sw != compile_switch && sw != equivalence_switch && sw != timing_switch && sw != toggles_switch && sw != activity_switch && sw != outputs_switch && sw != waveform_switch && sw != waveform_nodes_switch && sw != waveform_levels_switch ){
 					return "error: unrecognized command line option: '" + sw +"'\n"  + more_info + "\n";
 				}					
 				if( i == argc - 1 ){
-					return "error: missing filename after: '" + sw + "'\n" + more_info + "\n";
+					return "error: missing parameter after: '" + sw + "'\n" + more_info + "\n";
 				}
 				std::string param(argv[i+1]);
 				if( sw == input_switch ){
-					input_file = param;
+					options.input_file = param;
 				}
 				else if( sw == circuit_switch ){
-					circuit_file = param;
+					options.circuit_file = param;
 				}else if( sw == output_switch ){
-					output_file = param;
+					options.output_file = param;
+				}else if( sw == pack_switch ){
+					options.packed_file = param;
+				}else if( sw == equivalence_switch ){
+					options.equivalent_file = param;
+				}else if( sw == compile_switch ){
+					options.circuit_file = param;
+					options.compile = true;
+				}else if( sw == server_switch ){
+					options.server_socket = param;
+				}else if( sw == client_switch ){
+					options.client_socket = param;
+				}else if( sw == timing_switch ){
+					options.delays_file = param;
+				}else if( sw == toggles_switch ){
+					options.toggles_file = param;
+				}else if( sw == activity_switch ){
+					options.activity_file = param;
+				}else if( sw == waveform_switch ){
+					options.waveform_file = param;
+				}else if( sw == waveform_nodes_switch ){
+					if( !parse_nodes( param, options.waveform_nodes ) ){
+						return "error: incorrect list of nodes: '" + param + "'\n" + more_info + "\n";
+					}
+				}else if( sw == outputs_switch ){
+					if( !parse_nodes( param, options.outputs ) ){
+						return "error: incorrect list of outputs: '" + param + "'\n" + more_info + "\n";
+					}
+				}else if( sw == waveform_levels_switch ){
+					size_t colon = param.find( ':' );
+					std::string min_level = param.substr( 0, colon );
+					std::string max_level = colon == std::string::npos ? "" : param.substr( colon + 1 );
+					if( min_level.empty() || max_level.empty() || ( min_level + max_level ).find_first_not_of( "0123456789" ) != std::string::npos || min_level.size() > 9 || max_level.size() > 9 || std::stoi( min_level ) > std::stoi( max_level ) ){
+						return "error: incorrect range of levels: '" + param + "'\n" + more_info + "\n";
+					}
+					options.waveform_min_level = std::stoi( min_level );
+					options.waveform_max_level = std::stoi( max_level );
+				}else if( sw == stats_file_switch ){
+					options.stats_file = param;
+				}else if( sw == width_switch ){
+					if( param != "64" && param != "256" && param != "512" ){
+						return "error: incorrect number of parallel vectors: '" + param + "'\n" + more_info + "\n";
+					}
+					options.width = std::stoi( param );
+				}else if( sw == threads_switch ){
+					if( param.find_first_not_of( "0123456789" ) != std::string::npos || param.size() > 4 || std::stoi( param ) < 1 ){
+						return "error: incorrect number of threads: '" + param + "'\n" + more_info + "\n";
+					}
+					options.threads = std::stoi( param );
+				}else if( sw == testbenches_switch ){
+					if( param.find_first_not_of( "0123456789" ) != std::string::npos || param.size() > 9 || std::stoi( param ) < 1 ){
+						return "error: incorrect number of testbenches: '" + param + "'\n" + more_info + "\n";
+					}
+					options.testbenches = std::stoi( param );
+				}else if( sw == stream_switch ){
+					if( param.find_first_not_of( "0123456789" ) != std::string::npos || param.size() > 9 || std::stoi( param ) < 1 ){
+						return "error: incorrect batch size: '" + param + "'\n" + more_info + "\n";
+					}
+					options.batch_size = std::stoi( param );
 				}
 				i++;
 			}
@@ -64,13 +209,52 @@ std::string parse_options( int argc, char** argv, std::string & input_file,
 		}
 	}
 
-	if( input_file == "" ){
+	if( options.server_socket != "" ){
+		return "";
+	}
+	if( options.event_driven && options.testbenches > 1 ){
+		return "error: event driven evaluation simulates single testbench\n" + more_info + "\n";
+	}
+	//Optimization keeps only two-valued behaviour, it would change where X appears
+	if( options.four_valued && ( options.event_driven || options.native || options.optimize || options.binary_output ) ){
+		return "error: four-valued simulation is evaluated bit-parallel on the circuit as written, without native code, and written as text\n" + more_info + "\n";
+	}
+	if( options.faults && ( options.event_driven || options.four_valued || options.binary_output || options.batch_size || options.exhaustive ) ){
+		return "error: fault simulation reads all input vectors at once, evaluates them bit-parallel and writes text report\n" + more_info + "\n";
+	}
+	//Optimization removes and merges nodes, so their faults would be lost or reported for nodes missing in the file
+	if( options.faults && options.optimize ){
+		return "error: fault simulation is evaluated on the circuit as written\n" + more_info + "\n";
+	}
+	if( options.delays_file != "" && ( options.event_driven || options.four_valued || options.binary_output || options.batch_size || options.testbenches > 1 || options.exhaustive || options.faults || options.equivalent_file != "" ) ){
+		return "error: timing simulation evaluates single testbench read at once vector by vector and writes text\n" + more_info + "\n";
+	}
+	//Optimization merges and rewrites gates, so delays given for nodes and gate types of the file would not apply to them
+	if( options.delays_file != "" && options.optimize ){
+		return "error: timing simulation is evaluated on the circuit as written\n" + more_info + "\n";
+	}
+	if( options.toggles_file != "" && options.delays_file == "" ){
+		return "error: toggles are counted only by timing simulation\n" + more_info + "\n";
+	}
+	if( options.activity_file != "" && ( options.event_driven || options.four_valued || options.testbenches > 1 || options.exhaustive || options.faults || options.delays_file != "" || options.equivalent_file != "" || options.client_socket != "" ) ){
+		return "error: activity is counted by two-valued bit-parallel simulation of read input vectors, run locally\n" + more_info + "\n";
+	}
+	if( options.waveform_file != "" && ( options.event_driven || options.four_valued || options.testbenches > 1 || options.exhaustive || options.faults || options.delays_file != "" || options.equivalent_file != "" || options.client_socket != "" ) ){
+		return "error: waveform is written by two-valued bit-parallel simulation of read input vectors, run locally\n" + more_info + "\n";
+	}
+	if( options.waveform_file == "" && ( !options.waveform_nodes.empty() || options.waveform_min_level != 0 || options.waveform_max_level != UINT32_MAX ) ){
+		return "error: nodes of the waveform are selected without waveform file\n" + more_info + "\n";
+	}
+	if( !options.outputs.empty() && ( options.equivalent_file != "" || options.client_socket != "" ) ){
+		return "error: outputs are selected only for local simulation of a single circuit\n" + more_info + "\n";
+	}
+	if( options.input_file == "" && !options.compile && !options.exhaustive && options.equivalent_file == "" ){
 		return "error: File with inputs not specified\n" + more_info + "\n";
 	}
-	if( circuit_file == "" ){
+	if( options.circuit_file == "" ){
 		return "error: File with circuit not specified\n" + more_info + "\n";
 	}
-	if( output_file == "" ){
+	if( options.output_file == "" && options.packed_file == "" && options.equivalent_file == "" ){
 		return "error: File with outputs not specified\n" + more_info + "\n";
 	}
 
@@ -8,15 +8,51 @@
 #ifndef PARSE_OPTIONS_H
 #define PARSE_OPTIONS_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+Structure holding settings read from command line parameters
+*/
+struct Options{
+	std::string input_file;/**< Name of file containing inputs*/
+	std::string circuit_file;/**< Name of file containing circuit structure*/
+	std::string output_file;/**< Name of file containing outputs*/
+	int width = 64;/**< Number of input vectors simulated in parallel*/
+	int threads = 1;/**< Number of threads evaluating input vectors*/
+	int testbenches = 1;/**< Number of independent testbenches of sequential circuit, consecutive input vectors are their consecutive clock cycles*/
+	std::string packed_file;/**< Name of file the inputs are packed into, empty if inputs are simulated*/
+	bool binary_output = false;/**< Flag set if outputs are written in the packed binary format*/
+	std::vector< int > outputs;/**< Numbers of the simulated output nodes, empty if all outputs are simulated*/
+	bool exhaustive = false;/**< Flag set if every assignment of the inputs is simulated instead of reading them*/
+	std::string equivalent_file;/**< Name of file containing circuit compared with the simulated one, empty if circuits are not compared*/
+	bool compile = false;/**< Flag set if the built circuit is written into binary snapshot in the output file instead of being simulated*/
+	bool optimize = false;/**< Flag set if redundant logic is removed from the circuit before simulation*/
+	bool native = false;/**< Flag set if the circuit is compiled to native code*/
+	bool event_driven = false;/**< Flag set if input vectors are evaluated event driven*/
+	bool four_valued = false;/**< Flag set if values 0, 1, X and Z are simulated*/
+	std::string delays_file;/**< Name of file containing delays of the gates, empty if input vectors are simulated without delays*/
+	std::string toggles_file;/**< Name of file toggles and glitches of the nodes are written to, empty if they are not written*/
+	std::string activity_file;/**< Name of file ones and toggles of the nodes of bit-parallel simulation are written to, empty if they are not counted*/
+	std::string waveform_file;/**< Name of Value Change Dump file values of the nodes of bit-parallel simulation are written to, empty if they are not written*/
+	std::vector< int > waveform_nodes;/**< Numbers of the nodes written to the waveform file, empty if all nodes are written*/
+	uint32_t waveform_min_level = 0;/**< Minimal level of the nodes written to the waveform file*/
+	uint32_t waveform_max_level = UINT32_MAX;/**< Maximal level of the nodes written to the waveform file*/
+	bool faults = false;/**< Flag set if input vectors are graded by stuck-at faults instead of writing the outputs*/
+	size_t batch_size = 0;/**< Number of input vectors in a batch of streamed simulation, 0 if inputs are read at once*/
+	bool stats = false;/**< Flag set if statistics of the simulation are printed*/
+	std::string server_socket;/**< Path of the socket the server listens on, empty if not running as server*/
+	std::string client_socket;/**< Path of the socket of the server the job is sent to, empty if simulated locally*/
+	std::string stats_file;/**< Name of file the statistics are written to in JSON format, empty if they are not written*/
+};
+
 /**
 	Function parses command line parameters and figures out input and output files
 	@param argv array of c strings containing command line parameters
 	@param argc length of argv 
-	@param [in,out] input_file name of file containing inputs
-	@param [in,out] circuit_file name of file containing circuit structure
-	@param [in,out] output_file name of file containing outputs
+	@param [in,out] options structure filled with the settings
 */
-std::string parse_options( int argc, char** argv, std::string & input_file,  
-	std::string & circuit_file, std::string & output_file );
+std::string parse_options( int argc, char** argv, Options & options );
 
-#endif
\ No newline at end of file
+#endif
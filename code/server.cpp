@@ -0,0 +1,401 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "mapped_file.h"
+#include "server.h"
+#include "vector_file.h"
+
+//Server evaluates inputs in batches of at least this many bytes, so outputs are streamed back while the inputs are still arriving
+static const size_t batch_bytes = 1 << 20;
+
+/**
+	Function sends whole buffer through the socket.
+	@param descriptor Descriptor of the socket.
+	@param data Sent data.
+	@param size Length of the data.
+	@return Function returns false if the connection has been broken.
+*/
+static bool send_all( int descriptor, const char * data, size_t size ){
+	while( size ){
+		ssize_t sent = send( descriptor, data, size, MSG_NOSIGNAL );
+		if( sent <= 0 ){
+			return false;
+		}
+		data += sent;
+		size -= sent;
+	}
+	return true;
+}
+
+/**
+	Function receives exactly given number of bytes from the socket.
+	@param descriptor Descriptor of the socket.
+	@param [out] data Buffer for the received data.
+	@param size Number of bytes to be received.
+	@return Function returns false if the connection has been closed before all bytes arrived.
+*/
+static bool receive_all( int descriptor, char * data, size_t size ){
+	while( size ){
+		ssize_t received = recv( descriptor, data, size, 0 );
+		if( received <= 0 ){
+			return false;
+		}
+		data += received;
+		size -= received;
+	}
+	return true;
+}
+
+/**
+	Function sends frame of the server answer.
+	@param descriptor Descriptor of the socket.
+	@param type Type of the frame, 'O' for outputs, 'E' for errors and warnings.
+	@param payload Content of the frame.
+	@return Function returns false if the connection has been broken.
+*/
+static bool send_frame( int descriptor, char type, const std::string & payload ){
+	char header[ 5 ];
+	uint32_t length = payload.size();
+	header[0] = type;
+	memcpy( header + 1, &length, sizeof( length ) );
+	return send_all( descriptor, header, sizeof( header ) ) && send_all( descriptor, payload.data(), payload.size() );
+}
+
+/**
+	Function computes 64-bit FNV-1a hash of the data.
+	@param data Hashed data.
+	@param size Length of the data.
+	@param hash Initial value of the hash, allows hashing data in pieces.
+	@return Function returns the hash.
+*/
+static uint64_t content_hash( const char * data, size_t size, uint64_t hash = 14695981039346656037ull ){
+	for( size_t i = 0; i < size; i++ ){
+		hash = ( hash ^ ( unsigned char )data[i] ) * 1099511628211ull;
+	}
+	return hash;
+}
+
+/**
+	Constructor with socket settings.
+	@param socket_fname Path of the socket.
+	@param threads Number of threads evaluating every circuit.
+	@param capacity Maximal number of cached circuits.
+*/
+Server::Server( const std::string & socket_fname, int threads, size_t capacity ){
+	this->socket_fname = socket_fname;
+	this->threads = threads;
+	this->capacity = capacity;
+	this->descriptor = -1;
+}
+
+/**
+	Destructor closing and removing the socket.
+*/
+Server::~Server(){
+	if( this->descriptor >= 0 ){
+		close( this->descriptor );
+		unlink( this->socket_fname.c_str() );
+	}
+}
+
+/** Method finds circuit in the cache or builds it.
+	@param fname Name of the circuit file.
+	@param width Number of input vectors simulated in parallel.
+	@param optimize True if the circuit is optimized.
+	@param native True if the circuit is compiled to native code.
+	@param [out] messages Errors and warnings encountered while building the circuit.
+	@return Method returns the circuit or NULL if it couldn't be built.
+*/
+Circuit * Server::find( const std::string & fname, int width, bool optimize, bool native, std::vector< std::string > & messages ){
+	MappedFile file;
+	if( !file.open( fname ) ){
+		messages.push_back( "error: Couldn't open circuit file for reading!" );
+		return NULL;
+	}
+	//Native code is compiled for the number of parallel vectors, so it is a part of the key too
+	char settings[] = { char( width / 64 ), char( optimize ), char( native ) };
+	uint64_t key = content_hash( settings, sizeof( settings ), content_hash( file.data(), file.size() ) );
+	file.close();
+
+	for( auto entry = this->cache.begin(); entry != this->cache.end(); entry++ ){
+		if( entry->key == key ){
+			this->cache.splice( this->cache.begin(), this->cache, entry );
+			return entry->circuit.get();
+		}
+	}
+
+	std::unique_ptr< Circuit > circuit( new Circuit() );
+	circuit->set_threads( this->threads );
+	circuit->set_width( width );
+	circuit->build( fname );
+	messages = circuit->get_errors();
+	if( !circuit->good() ){
+		return NULL;
+	}
+	if( optimize ){
+		circuit->optimize();
+	}
+	if( native ){
+		circuit->compile_native();
+	}
+	messages = circuit->get_errors();
+	circuit->clear_errors();
+
+	this->cache.push_front( { key, std::move( circuit ) } );
+	if( this->cache.size() > this->capacity ){
+		this->cache.pop_back();
+	}
+	return this->cache.front().circuit.get();
+}
+
+/** Method serves single client.
+	@param connection Descriptor of the connection.
+*/
+void Server::serve( int connection ){
+	//Reading header lines, the text after the empty line already belongs to the inputs
+	std::string pending;
+	size_t header_end;
+	char chunk[ 65536 ];
+	while( ( header_end = pending.find( "\n\n" ) ) == std::string::npos ){
+		ssize_t received = recv( connection, chunk, sizeof( chunk ), 0 );
+		if( received <= 0 ){
+			return;
+		}
+		pending.append( chunk, received );
+	}
+	std::string circuit_fname;
+	std::string input_fname = "inputs";
+	int width = 64;
+	int testbenches = 1;
+	bool event_driven = false;
+	bool four_valued = false;
+	bool optimize = false;
+	bool native = false;
+	size_t line_begin = 0;
+	while( line_begin < header_end ){
+		size_t line_end = pending.find( '\n', line_begin );
+		std::string line = pending.substr( line_begin, line_end - line_begin );
+		line_begin = line_end + 1;
+		size_t separator = line.find( ' ' );
+		std::string name = line.substr( 0, separator );
+		std::string value = separator == std::string::npos ? "" : line.substr( separator + 1 );
+		if( name == "circuit" ){
+			circuit_fname = value;
+		}else if( name == "inputs" ){
+			input_fname = value;
+		}else if( name == "width" ){
+			width = atoi( value.c_str() );
+		}else if( name == "testbenches" ){
+			testbenches = atoi( value.c_str() );
+		}else if( name == "event" ){
+			event_driven = value == "1";
+		}else if( name == "four_valued" ){
+			four_valued = value == "1";
+		}else if( name == "optimize" ){
+			optimize = value == "1";
+		}else if( name == "native" ){
+			native = value == "1";
+		}else{
+			send_frame( connection, 'E', "error: unknown request field: " + name );
+			return;
+		}
+	}
+	pending.erase( 0, header_end + 2 );
+
+	if( width != 64 && width != 256 && width != 512 ){
+		send_frame( connection, 'E', "error: unsupported number of parallel vectors: " + std::to_string( width ) );
+		return;
+	}
+	if( four_valued && optimize ){
+		send_frame( connection, 'E', "error: four-valued simulation is evaluated on the circuit as written" );
+		return;
+	}
+	std::vector< std::string > messages;
+	Circuit * circuit = this->find( circuit_fname, width, optimize, native, messages );
+	for( const auto & message : messages ){
+		send_frame( connection, 'E', message );
+	}
+	if( circuit == NULL ){
+		return;
+	}
+	circuit->set_event_driven( event_driven );
+	circuit->set_four_valued( four_valued );
+	//Cached circuit starts every job from the first clock cycle
+	if( !circuit->set_testbenches( testbenches ) ){
+		send_frame( connection, 'E', circuit->get_last_error() );
+		circuit->clear_errors();
+		return;
+	}
+	circuit->reset_registers();
+
+	//Complete lines are evaluated in batches while the rest of the inputs is being received
+	int line = 1;
+	bool finished = false;
+	std::string output;
+	while( !finished ){
+		ssize_t received = recv( connection, chunk, sizeof( chunk ), 0 );
+		if( received <= 0 ){
+			finished = true;
+		}else{
+			pending.append( chunk, received );
+		}
+		if( pending.size() < batch_bytes && !finished ){
+			continue;
+		}
+		size_t cut = finished ? pending.size() : pending.rfind( '\n' ) + 1;
+		if( cut == 0 ){
+			continue;
+		}
+		//Batch holds whole clock cycles of all testbenches, the remaining lines wait for the next one
+		//Only lines with any token are read as sets, blank lines don't count
+		if( !finished ){
+			int sets = 0;
+			size_t whole = 0;
+			bool blank = true;
+			for( size_t i = 0; i < cut; i++ ){
+				if( pending[i] == '\n' ){
+					if( !blank && ++sets % testbenches == 0 ){
+						whole = i + 1;
+					}
+					blank = true;
+				}else if( pending[i] != ' ' && pending[i] != '\t' && pending[i] != '\r' ){
+					blank = false;
+				}
+			}
+			cut = whole;
+		}
+		if( cut == 0 ){
+			continue;
+		}
+		circuit->evaluate_text( pending.data(), pending.data() + cut, input_fname, line, output );
+		line += std::count( pending.begin(), pending.begin() + cut, '\n' );
+		pending.erase( 0, cut );
+		bool connected = send_frame( connection, 'O', output );
+		for( const auto & message : circuit->get_errors() ){
+			connected = connected && send_frame( connection, 'E', message );
+		}
+		circuit->clear_errors();
+		if( !connected ){
+			return;
+		}
+	}
+}
+
+/** Method listens on the socket and serves clients until an error occurs.
+	@return Method returns an error message.
+*/
+std::string Server::run(){
+	sockaddr_un address;
+	memset( &address, 0, sizeof( address ) );
+	address.sun_family = AF_UNIX;
+	if( this->socket_fname.size() >= sizeof( address.sun_path ) ){
+		return "error: socket path is too long: " + this->socket_fname;
+	}
+	strcpy( address.sun_path, this->socket_fname.c_str() );
+
+	this->descriptor = socket( AF_UNIX, SOCK_STREAM, 0 );
+	if( this->descriptor < 0 ){
+		return "error: Couldn't create socket!";
+	}
+	//Socket left by a previous server is replaced
+	unlink( this->socket_fname.c_str() );
+	if( bind( this->descriptor, ( sockaddr * )&address, sizeof( address ) ) != 0 || listen( this->descriptor, 16 ) != 0 ){
+		return "error: Couldn't listen on socket: " + this->socket_fname;
+	}
+	while( true ){
+		int connection = accept( this->descriptor, NULL, NULL );
+		if( connection < 0 ){
+			if( errno == EINTR ){
+				continue;
+			}
+			return "error: Couldn't accept connection on socket: " + this->socket_fname;
+		}
+		this->serve( connection );
+		close( connection );
+	}
+}
+
+/** Function sends simulation job to the server and writes received outputs into the output file.
+	Warnings reported by the server are printed to the standard output.
+	@param socket_fname Path of the socket of the server.
+	@param options Settings of the job.
+	@return Function returns empty string on success, otherwise returns an error message.
+*/
+std::string Server::request( const std::string & socket_fname, const Options & options ){
+	if( options.binary_output || VectorFile::is_binary( options.input_file ) ){
+		return "error: binary files are not supported by the server";
+	}
+	MappedFile input_file;
+	if( !input_file.open( options.input_file ) ){
+		return "error: Couldn't open inputs file for reading!";
+	}
+	std::ofstream output_file( options.output_file );
+	if( !output_file ){
+		return "error: Couldn't open output file for writing!";
+	}
+
+	sockaddr_un address;
+	memset( &address, 0, sizeof( address ) );
+	address.sun_family = AF_UNIX;
+	if( socket_fname.size() >= sizeof( address.sun_path ) ){
+		return "error: socket path is too long: " + socket_fname;
+	}
+	strcpy( address.sun_path, socket_fname.c_str() );
+	int descriptor = socket( AF_UNIX, SOCK_STREAM, 0 );
+	if( descriptor < 0 || connect( descriptor, ( sockaddr * )&address, sizeof( address ) ) != 0 ){
+		if( descriptor >= 0 ){
+			close( descriptor );
+		}
+		return "error: Couldn't connect to server: " + socket_fname;
+	}
+
+	//Server reads the circuit itself, so its path has to be absolute
+	std::string header = "circuit " + std::filesystem::absolute( options.circuit_file ).string() + "\n" +
+	"inputs " + options.input_file + "\n" +
+	"width " + std::to_string( options.width ) + "\n" +
+	"testbenches " + std::to_string( options.testbenches ) + "\n" +
+	"event " + ( options.event_driven ? "1" : "0" ) + "\n" +
+	"four_valued " + ( options.four_valued ? "1" : "0" ) + "\n" +
+	"optimize " + ( options.optimize ? "1" : "0" ) + "\n" +
+	"native " + ( options.native ? "1" : "0" ) + "\n\n";
+
+	//Inputs are sent by a separate thread, so outputs streamed back never fill the socket and block the server
+	std::thread sender( [ & ](){
+		if( send_all( descriptor, header.data(), header.size() ) ){
+			send_all( descriptor, input_file.data(), input_file.size() );
+		}
+		shutdown( descriptor, SHUT_WR );
+	} );
+
+	std::string payload;
+	char frame[ 5 ];
+	while( receive_all( descriptor, frame, sizeof( frame ) ) ){
+		uint32_t length;
+		memcpy( &length, frame + 1, sizeof( length ) );
+		payload.resize( length );
+		if( !receive_all( descriptor, &payload[0], length ) ){
+			break;
+		}
+		if( frame[0] == 'O' ){
+			output_file.write( payload.data(), payload.size() );
+		}else{
+			std::cout<<payload<<std::endl;
+		}
+	}
+	sender.join();
+	close( descriptor );
+	if( !output_file ){
+		return "error: Couldn't write output file!";
+	}
+	return "";
+}
@@ -0,0 +1,91 @@
+/**
+ * @file server.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of simulation server keeping built circuits between jobs.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "circuit.h"
+#include "parse_options.h"
+
+/**
+Class of the long running simulation server listening on a Unix domain socket.
+Built circuits are kept in a least recently used cache keyed by hash of the content of the circuit file and the settings they were prepared with,
+so repeated jobs skip parsing, optimization and native compilation. Clients are served one at a time.
+
+Client sends header lines "circuit <absolute path>", "inputs <name used in warnings>", "width <n>", "testbenches <n>", "event <0|1>", "four_valued <0|1>", "optimize <0|1>" and "native <0|1>" ended by an empty line,
+followed by input vectors in the text format until it shuts down its side of the connection.
+Server answers with frames consisting of type byte, 32-bit length and payload: 'O' frames carry outputs in the text format as soon as batches are evaluated,
+'E' frames carry errors and warnings.
+ */
+class Server
+{
+	/**
+	Structure holding cached circuit.
+	*/
+	struct Entry{
+		uint64_t key;/**< Hash of the circuit file and settings the circuit was prepared with*/
+		std::unique_ptr< Circuit > circuit;/**< Built circuit*/
+	};
+
+	std::string socket_fname;			//**<Path of the socket
+	int threads;						//**<Number of threads evaluating every circuit
+	size_t capacity;					//**<Maximal number of cached circuits
+	std::list< Entry > cache;			//**<Cached circuits, the most recently used first
+	int descriptor;						//**<Descriptor of the listening socket, -1 if it is not opened
+
+	/** Method finds circuit in the cache or builds it.
+		@param fname Name of the circuit file.
+		@param width Number of input vectors simulated in parallel.
+		@param optimize True if the circuit is optimized.
+		@param native True if the circuit is compiled to native code.
+		@param [out] messages Errors and warnings encountered while building the circuit.
+		@return Method returns the circuit or NULL if it couldn't be built.
+	*/
+	Circuit * find( const std::string & fname, int width, bool optimize, bool native, std::vector< std::string > & messages );
+
+	/** Method serves single client.
+		@param connection Descriptor of the connection.
+	*/
+	void serve( int connection );
+
+public:
+	/**
+		Constructor with socket settings.
+		@param socket_fname Path of the socket.
+		@param threads Number of threads evaluating every circuit.
+		@param capacity Maximal number of cached circuits.
+	*/
+	Server( const std::string & socket_fname, int threads, size_t capacity );
+
+	/**
+		Destructor closing and removing the socket.
+	*/
+	~Server();
+
+	Server( const Server & ) = delete;
+	Server & operator=( const Server & ) = delete;
+
+	/** Method listens on the socket and serves clients until an error occurs.
+		@return Method returns an error message.
+	*/
+	std::string run();
+
+	/** Function sends simulation job to the server and writes received outputs into the output file.
+		Warnings reported by the server are printed to the standard output.
+		@param socket_fname Path of the socket of the server.
+		@param options Settings of the job.
+		@return Function returns empty string on success, otherwise returns an error message.
+	*/
+	static std::string request( const std::string & socket_fname, const Options & options );
+};
+
+#endif
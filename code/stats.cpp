@@ -0,0 +1,278 @@
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "stats.h"
+
+static const uint64_t hardware_events[] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+static const char * hardware_names[] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+
+/**
+	@return Function returns CPU time of the process in seconds.
+*/
+static double cpu_time(){
+	timespec time;
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &time );
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+/**
+	Constructor opening the hardware counters.
+*/
+Stats::Stats(){
+	for( uint64_t event : hardware_events ){
+		perf_event_attr attributes;
+		memset( &attributes, 0, sizeof( attributes ) );
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof( attributes );
+		attributes.config = event;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		int descriptor = syscall( SYS_perf_event_open, &attributes, 0, -1, -1, 0 );
+		if( descriptor < 0 ){
+			//Counters are reported all or none
+			for( int opened : this->descriptors ){
+				close( opened );
+			}
+			this->descriptors.clear();
+			break;
+		}
+		this->descriptors.push_back( descriptor );
+	}
+	this->cpu_start = 0;
+}
+
+/**
+	Destructor closing the hardware counters.
+*/
+Stats::~Stats(){
+	for( int descriptor : this->descriptors ){
+		close( descriptor );
+	}
+}
+
+/**
+	@return Method returns current values of the hardware counters.
+*/
+std::vector< uint64_t > Stats::read_hardware() const{
+	std::vector< uint64_t > values( this->descriptors.size() );
+	for( size_t i = 0; i < this->descriptors.size(); i++ ){
+		if( read( this->descriptors[i], &values[i], sizeof( values[i] ) ) != sizeof( values[i] ) ){
+			values[i] = 0;
+		}
+	}
+	return values;
+}
+
+/** Method starts measuring a phase.
+	@param name Name of the phase.
+*/
+void Stats::begin( const std::string & name ){
+	this->phases.push_back( { name, 0, 0, {} } );
+	this->hardware_start = this->read_hardware();
+	this->cpu_start = cpu_time();
+	this->wall_start = std::chrono::steady_clock::now();
+}
+
+/** Method finishes measuring the current phase. */
+void Stats::end(){
+	Phase & phase = this->phases.back();
+	phase.wall = std::chrono::duration< double >( std::chrono::steady_clock::now() - this->wall_start ).count();
+	phase.cpu = cpu_time() - this->cpu_start;
+	phase.hardware = this->read_hardware();
+	for( size_t i = 0; i < phase.hardware.size(); i++ ){
+		phase.hardware[i] -= this->hardware_start[i];
+	}
+}
+
+/**
+	@return Method returns wall time of the phases evaluating sets of input data.
+*/
+double Stats::evaluation_time() const{
+	double time = 0;
+	for( const auto & phase : this->phases ){
+		if( phase.name == "evaluate" || phase.name == "simulate" || phase.name == "enumerate" || phase.name == "compare" || phase.name == "faults" ){
+			time += phase.wall;
+		}
+	}
+	return time;
+}
+
+/** Function counts values in buckets of powers of two, bucket 0 holds zeros and bucket k values in [ 2^(k-1), 2^k ).
+	@param values Counted values.
+	@return Function returns number of values in every bucket.
+*/
+std::vector< uint64_t > Stats::histogram( const std::vector< uint32_t > & values ){
+	std::vector< uint64_t > buckets;
+	for( uint32_t value : values ){
+		size_t bucket = 0;
+		while( value >> bucket ){
+			bucket++;
+		}
+		if( buckets.size() <= bucket ){
+			buckets.resize( bucket + 1 );
+		}
+		buckets[ bucket ]++;
+	}
+	return buckets;
+}
+
+/**
+	@param bucket Index of the bucket of histogram.
+	@return Function returns range of values counted in the bucket.
+*/
+std::string Stats::bucket_range( size_t bucket ){
+	if( bucket <= 1 ){
+		return std::to_string( bucket );
+	}
+	return std::to_string( uint64_t( 1 ) << ( bucket - 1 ) ) + "-" + std::to_string( ( uint64_t( 1 ) << bucket ) - 1 );
+}
+
+/**
+	@return Function returns peak resident set size of the process in kilobytes.
+*/
+long Stats::peak_rss(){
+	rusage usage;
+	getrusage( RUSAGE_SELF, &usage );
+	return usage.ru_maxrss;
+}
+
+/**
+	@param netlist Netlist of the circuit.
+	@return Function returns number of gates at every level, level 0 holds the inputs.
+*/
+static std::vector< uint32_t > level_widths( const Netlist & netlist ){
+	std::vector< uint32_t > widths( netlist.size() ? netlist.depth() + 1 : 0 );
+	for( uint32_t level : netlist.levels ){
+		widths[ level ]++;
+	}
+	return widths;
+}
+
+/**
+	@param netlist Netlist of the circuit.
+	@return Function returns number of gates driven by every node.
+*/
+static std::vector< uint32_t > fanout_counts( const Netlist & netlist ){
+	std::vector< uint32_t > counts( netlist.size() );
+	for( uint32_t node = 0; node < netlist.size(); node++ ){
+		counts[ node ] = netlist.fanout_offsets[ node + 1 ] - netlist.fanout_offsets[ node ];
+	}
+	return counts;
+}
+
+/** Method formats human readable report.
+	@param counters Counters of the circuit.
+	@param netlist Netlist of the circuit.
+	@return Method returns text of the report.
+*/
+std::string Stats::report( const Counters & counters, const Netlist & netlist ) const{
+	std::ostringstream text;
+	text<<std::fixed<<std::setprecision( 3 );
+	text<<std::left<<std::setw( 16 )<<"phase"<<std::right<<std::setw( 14 )<<"wall [ms]"<<std::setw( 14 )<<"cpu [ms]";
+	for( size_t i = 0; i < this->descriptors.size(); i++ ){
+		text<<std::setw( 16 )<<hardware_names[i];
+	}
+	text<<"\n";
+	for( const auto & phase : this->phases ){
+		text<<std::left<<std::setw( 16 )<<phase.name<<std::right<<std::setw( 14 )<<phase.wall * 1000<<std::setw( 14 )<<phase.cpu * 1000;
+		for( uint64_t value : phase.hardware ){
+			text<<std::setw( 16 )<<value;
+		}
+		text<<"\n";
+	}
+	if( this->descriptors.empty() ){
+		text<<"hardware counters: unavailable\n";
+	}else{
+		text<<"hardware counters: calling thread only\n";
+	}
+	double evaluation = this->evaluation_time();
+	text<<"bytes parsed: "<<counters.bytes_parsed<<"\n";
+	text<<"vectors: "<<counters.vectors<<" ("<<std::setprecision( 0 )<<( evaluation > 0 ? counters.vectors / evaluation : 0 )<<" vectors/s)\n";
+	text<<"gates evaluated: "<<counters.gates_evaluated<<" skipped: "<<counters.gates_skipped<<"\n";
+	if( counters.events ){
+		text<<"events: "<<counters.events<<" ("<<std::setprecision( 0 )<<( evaluation > 0 ? counters.events / evaluation : 0 )<<" events/s)\n";
+	}
+	text<<"peak RSS: "<<Stats::peak_rss()<<" kB\n";
+	text<<"nodes: "<<netlist.size()<<" inputs: "<<netlist.input_count<<" depth: "<<netlist.depth()<<"\n";
+	text<<"levels by number of nodes:";
+	std::vector< uint64_t > levels = Stats::histogram( level_widths( netlist ) );
+	for( size_t bucket = 0; bucket < levels.size(); bucket++ ){
+		if( levels[ bucket ] ){
+			text<<" "<<Stats::bucket_range( bucket )<<":"<<levels[ bucket ];
+		}
+	}
+	text<<"\nnodes by fanout:";
+	std::vector< uint64_t > fanouts = Stats::histogram( fanout_counts( netlist ) );
+	for( size_t bucket = 0; bucket < fanouts.size(); bucket++ ){
+		if( fanouts[ bucket ] ){
+			text<<" "<<Stats::bucket_range( bucket )<<":"<<fanouts[ bucket ];
+		}
+	}
+	text<<"\n";
+	return text.str();
+}
+
+/** Method writes the report as a JSON object.
+	@param fname Name of the file the report is written to.
+	@param counters Counters of the circuit.
+	@param netlist Netlist of the circuit.
+	@return Method returns empty string on success, otherwise returns an error message.
+*/
+std::string Stats::write_json( const std::string & fname, const Counters & counters, const Netlist & netlist ) const{
+	std::ofstream file( fname );
+	if( !file ){
+		return "error: Couldn't open stats file for writing!";
+	}
+	//Histograms are written as objects mapping ranges of values to counts
+	auto write_histogram = [ & ]( const std::vector< uint64_t > & buckets ){
+		file<<"{";
+		bool first = true;
+		for( size_t bucket = 0; bucket < buckets.size(); bucket++ ){
+			if( buckets[ bucket ] ){
+				file<<( first ? "" : ", " )<<"\""<<Stats::bucket_range( bucket )<<"\": "<<buckets[ bucket ];
+				first = false;
+			}
+		}
+		file<<"}";
+	};
+	double evaluation = this->evaluation_time();
+	file<<std::setprecision( 9 );
+	file<<"{\n\t\"phases\": [";
+	for( size_t i = 0; i < this->phases.size(); i++ ){
+		const Phase & phase = this->phases[i];
+		file<<( i ? "," : "" )<<"\n\t\t{\"name\": \""<<phase.name<<"\", \"wall\": "<<phase.wall<<", \"cpu\": "<<phase.cpu;
+		for( size_t j = 0; j < phase.hardware.size(); j++ ){
+			file<<", \""<<hardware_names[j]<<"\": "<<phase.hardware[j];
+		}
+		file<<"}";
+	}
+	file<<"\n\t],\n";
+	file<<"\t\"hardware_counters\": "<<( this->descriptors.empty() ? "false" : "true" )<<",\n";
+	file<<"\t\"bytes_parsed\": "<<counters.bytes_parsed<<",\n";
+	file<<"\t\"vectors\": "<<counters.vectors<<",\n";
+	file<<"\t\"vectors_per_second\": "<<( evaluation > 0 ? counters.vectors / evaluation : 0 )<<",\n";
+	file<<"\t\"gates_evaluated\": "<<counters.gates_evaluated<<",\n";
+	file<<"\t\"gates_skipped\": "<<counters.gates_skipped<<",\n";
+	file<<"\t\"events\": "<<counters.events<<",\n";
+	file<<"\t\"peak_rss_kb\": "<<Stats::peak_rss()<<",\n";
+	file<<"\t\"nodes\": "<<netlist.size()<<",\n";
+	file<<"\t\"inputs\": "<<netlist.input_count<<",\n";
+	file<<"\t\"depth\": "<<netlist.depth()<<",\n";
+	file<<"\t\"levels_by_nodes\": ";
+	write_histogram( Stats::histogram( level_widths( netlist ) ) );
+	file<<",\n\t\"nodes_by_fanout\": ";
+	write_histogram( Stats::histogram( fanout_counts( netlist ) ) );
+	file<<"\n}\n";
+	if( !file ){
+		return "error: Couldn't write stats file!";
+	}
+	return "";
+}
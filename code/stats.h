@@ -0,0 +1,116 @@
+/**
+ * @file stats.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of classes collecting statistics of the simulation.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "netlist.h"
+
+/**
+Structure holding counters of the work done by the circuit.
+*/
+struct Counters{
+	uint64_t bytes_parsed = 0;/**< Number of bytes of text files parsed*/
+	uint64_t vectors = 0;/**< Number of evaluated sets of input data*/
+	uint64_t gates_evaluated = 0;/**< Number of gate evaluations, counted once per set*/
+	uint64_t gates_skipped = 0;/**< Number of gate evaluations avoided by event driven evaluation*/
+	uint64_t events = 0;/**< Number of changes of nodes processed by timing simulation*/
+};
+
+/**
+Class measuring wall and CPU time of the phases of the simulation and reporting them together with counters of the circuit and shape of its netlist.
+Hardware counters of the calling thread are measured too if perf_event_open is available.
+ */
+class Stats
+{
+	/**
+	Structure holding measurements of a single phase.
+	*/
+	struct Phase{
+		std::string name;/**< Name of the phase*/
+		double wall;/**< Elapsed wall time in seconds*/
+		double cpu;/**< CPU time of the process in seconds, summed over all threads*/
+		std::vector< uint64_t > hardware;/**< Values of the hardware counters, empty if they are unavailable*/
+	};
+
+	std::vector< Phase > phases;							//**<Measured phases
+	std::vector< int > descriptors;							//**<Descriptors of the opened hardware counters, empty if they are unavailable
+	std::chrono::steady_clock::time_point wall_start;		//**<Moment the current phase has begun
+	double cpu_start;										//**<CPU time of the process at the beginning of the current phase
+	std::vector< uint64_t > hardware_start;					//**<Values of the hardware counters at the beginning of the current phase
+
+	/**
+		@return Method returns current values of the hardware counters.
+	*/
+	std::vector< uint64_t > read_hardware() const;
+
+	/**
+		@return Method returns wall time of the phases evaluating sets of input data.
+	*/
+	double evaluation_time() const;
+
+	/** Function counts values in buckets of powers of two, bucket 0 holds zeros and bucket k values in [ 2^(k-1), 2^k ).
+		@param values Counted values.
+		@return Function returns number of values in every bucket.
+	*/
+	static std::vector< uint64_t > histogram( const std::vector< uint32_t > & values );
+
+	/**
+		@param bucket Index of the bucket of histogram.
+		@return Function returns range of values counted in the bucket.
+	*/
+	static std::string bucket_range( size_t bucket );
+
+	/**
+		@return Function returns peak resident set size of the process in kilobytes.
+	*/
+	static long peak_rss();
+
+public:
+	/**
+		Constructor opening the hardware counters.
+	*/
+	Stats();
+
+	/**
+		Destructor closing the hardware counters.
+	*/
+	~Stats();
+
+	Stats( const Stats & ) = delete;
+	Stats & operator=( const Stats & ) = delete;
+
+	/** Method starts measuring a phase.
+		@param name Name of the phase.
+	*/
+	void begin( const std::string & name );
+
+	/** Method finishes measuring the current phase. */
+	void end();
+
+	/** Method formats human readable report.
+		@param counters Counters of the circuit.
+		@param netlist Netlist of the circuit.
+		@return Method returns text of the report.
+	*/
+	std::string report( const Counters & counters, const Netlist & netlist ) const;
+
+	/** Method writes the report as a JSON object.
+		@param fname Name of the file the report is written to.
+		@param counters Counters of the circuit.
+		@param netlist Netlist of the circuit.
+		@return Method returns empty string on success, otherwise returns an error message.
+	*/
+	std::string write_json( const std::string & fname, const Counters & counters, const Netlist & netlist ) const;
+};
+
+#endif
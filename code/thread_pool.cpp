@@ -0,0 +1,126 @@
+#include "thread_pool.h"
+
+/**
+	Constructor starting worker threads.
+	@param size Number of workers including the calling thread.
+*/
+ThreadPool::ThreadPool( int size ){
+	this->job = NULL;
+	this->generation = 0;
+	this->active = 0;
+	this->stopping = false;
+	for( int i = 0; i < size; i++ ){
+		this->queues.emplace_back( new Queue );
+	}
+	for( int i = 1; i < size; i++ ){
+		this->threads.emplace_back( &ThreadPool::loop, this, i );
+	}
+}
+
+/**
+	Destructor stopping worker threads.
+*/
+ThreadPool::~ThreadPool(){
+	{
+		std::lock_guard< std::mutex > lock( this->mutex );
+		this->stopping = true;
+	}
+	this->started.notify_all();
+	for( auto & thread : this->threads ){
+		thread.join();
+	}
+}
+
+/**
+	@return Method returns number of workers including the calling thread.
+*/
+int ThreadPool::size() const{
+	return this->queues.size();
+}
+
+/** Method runs the job on all workers and returns when every task has been finished.
+	Tasks are split into contiguous ranges, one range per worker, and balanced by stealing.
+	@param tasks Number of tasks.
+	@param job Function called with index of the task and index of the worker executing it.
+*/
+void ThreadPool::run( size_t tasks, const std::function< void( size_t, int ) > & job ){
+	size_t workers = this->queues.size();
+	for( size_t worker = 0; worker < workers; worker++ ){
+		std::lock_guard< std::mutex > lock( this->queues[ worker ]->mutex );
+		for( size_t task = tasks * worker / workers; task < tasks * ( worker + 1 ) / workers; task++ ){
+			this->queues[ worker ]->tasks.push_back( task );
+		}
+	}
+	{
+		std::lock_guard< std::mutex > lock( this->mutex );
+		this->job = &job;
+		this->active = this->threads.size();
+		this->generation++;
+	}
+	this->started.notify_all();
+	this->work( 0 );
+	std::unique_lock< std::mutex > lock( this->mutex );
+	this->finished.wait( lock, [ this ](){ return this->active == 0; } );
+	this->job = NULL;
+}
+
+/** Method executed by every worker, it runs tasks until all queues are empty.
+	@param worker Index of the worker.
+*/
+void ThreadPool::work( int worker ){
+	size_t task;
+	while( this->next( worker, task ) ){
+		( *this->job )( task, worker );
+	}
+}
+
+/** Method takes next task for the worker, stealing it from other workers if its own queue is empty.
+	@param worker Index of the worker.
+	@param [out] task Index of the task.
+	@return Method returns false if there are no more tasks.
+*/
+bool ThreadPool::next( int worker, size_t & task ){
+	{
+		Queue & own = *this->queues[ worker ];
+		std::lock_guard< std::mutex > lock( own.mutex );
+		if( !own.tasks.empty() ){
+			task = own.tasks.front();
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+	int workers = this->queues.size();
+	for( int i = 1; i < workers; i++ ){
+		Queue & victim = *this->queues[ ( worker + i ) % workers ];
+		std::lock_guard< std::mutex > lock( victim.mutex );
+		if( !victim.tasks.empty() ){
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Method executed by background threads, it waits for jobs and works on them.
+	@param worker Index of the worker.
+*/
+void ThreadPool::loop( int worker ){
+	size_t generation = 0;
+	while( true ){
+		{
+			std::unique_lock< std::mutex > lock( this->mutex );
+			this->started.wait( lock, [ this, generation ](){ return this->stopping || this->generation != generation; } );
+			if( this->stopping ){
+				return;
+			}
+			generation = this->generation;
+		}
+		this->work( worker );
+		{
+			std::lock_guard< std::mutex > lock( this->mutex );
+			this->active--;
+		}
+		this->finished.notify_one();
+	}
+}
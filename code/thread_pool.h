@@ -0,0 +1,86 @@
+/**
+ * @file thread_pool.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of pool of worker threads with work stealing.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+Class representing pool of worker threads.
+Every worker owns a queue of tasks, it takes tasks from the front of its own queue and when the queue runs dry it steals from the back of queues of other workers.
+Calling thread takes part in the work as worker 0.
+ */
+class ThreadPool
+{
+	/**
+	Structure representing queue of tasks owned by a single worker.
+	*/
+	struct Queue{
+		std::mutex mutex;/**< Mutex guarding the queue*/
+		std::deque< size_t > tasks;/**< Indices of tasks waiting for execution*/
+	};
+
+	std::vector< std::thread > threads;							//**<Background worker threads
+	std::vector< std::unique_ptr< Queue > > queues;				//**<Queues of tasks, one per worker
+	std::mutex mutex;											//**<Mutex guarding state of the pool
+	std::condition_variable started;							//**<Condition signalled when new job is available
+	std::condition_variable finished;							//**<Condition signalled when background worker has finished the job
+	const std::function< void( size_t, int ) > * job;			//**<Function executed for every task of current job
+	size_t generation;											//**<Number of current job, changes when new job is available
+	int active;													//**<Number of background workers still working on current job
+	bool stopping;												//**<Flag set when the pool is being destroyed
+
+	/** Method executed by every worker, it runs tasks until all queues are empty.
+		@param worker Index of the worker.
+	*/
+	void work( int worker );
+
+	/** Method takes next task for the worker, stealing it from other workers if its own queue is empty.
+		@param worker Index of the worker.
+		@param [out] task Index of the task.
+		@return Method returns false if there are no more tasks.
+	*/
+	bool next( int worker, size_t & task );
+
+	/** Method executed by background threads, it waits for jobs and works on them.
+		@param worker Index of the worker.
+	*/
+	void loop( int worker );
+
+public:
+	/**
+		Constructor starting worker threads.
+		@param size Number of workers including the calling thread.
+	*/
+	ThreadPool( int size );
+
+	/**
+		Destructor stopping worker threads.
+	*/
+	~ThreadPool();
+
+	/**
+		@return Method returns number of workers including the calling thread.
+	*/
+	int size() const;
+
+	/** Method runs the job on all workers and returns when every task has been finished.
+		Tasks are split into contiguous ranges, one range per worker, and balanced by stealing.
+		@param tasks Number of tasks.
+		@param job Function called with index of the task and index of the worker executing it.
+	*/
+	void run( size_t tasks, const std::function< void( size_t, int ) > & job );
+};
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file timing_wheel.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of event queue of the timing simulation.
+ */
+
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+Structure holding change of a node scheduled by the timing simulation.
+*/
+struct TimedEvent{
+	uint32_t node;/**< Index of the changing node*/
+	uint8_t value;/**< New value of the node, 0 or 0xFF*/
+	uint32_t depth;/**< Number of gates on the chain of changes causing this one*/
+};
+
+/**
+Class representing timing wheel, event queue for delays bounded by a known maximum.
+Events are kept in a ring of slots, one slot per time unit, so scheduling and taking events costs O(1) and slots keep their memory between uses.
+Every event has to be scheduled at least 1 and at most horizon time units after the current time.
+ */
+class TimingWheel
+{
+	std::vector< std::vector< TimedEvent > > slots;		//**<Ring of slots, slot t & mask holds events of time t
+	uint64_t mask;										//**<Number of slots minus 1, number of slots is a power of two
+	uint64_t now;										//**<Current time
+	size_t pending;										//**<Number of scheduled events not taken yet
+
+public:
+	/**
+		Constructor creating empty wheel.
+		@param horizon Maximal delay of the scheduled events.
+	*/
+	TimingWheel( uint32_t horizon ) : now( 0 ), pending( 0 ){
+		uint64_t size = 1;
+		while( size <= horizon ){
+			size <<= 1;
+		}
+		this->slots.resize( size );
+		this->mask = size - 1;
+	}
+
+	/** Method schedules event after the current time.
+		@param delay Number of time units after the current time, from 1 to the horizon.
+		@param event Scheduled event.
+	*/
+	void schedule( uint32_t delay, const TimedEvent & event ){
+		this->slots[ ( this->now + delay ) & this->mask ].push_back( event );
+		this->pending++;
+	}
+
+	/** Method moves to the earliest time with scheduled events, the wheel has to be non empty.
+		@return Method returns events of the new current time, caller clears them once they are processed.
+	*/
+	std::vector< TimedEvent > & advance(){
+		do{
+			this->now++;
+		}while( this->slots[ this->now & this->mask ].empty() );
+		std::vector< TimedEvent > & slot = this->slots[ this->now & this->mask ];
+		this->pending -= slot.size();
+		return slot;
+	}
+
+	/**
+		@return Method returns true if there are no scheduled events.
+	*/
+	bool empty() const{
+		return this->pending == 0;
+	}
+
+	/**
+		@return Method returns current time.
+	*/
+	uint64_t time() const{
+		return this->now;
+	}
+
+	/** Method sets current time back to 0, the wheel has to be empty. */
+	void restart(){
+		this->now = 0;
+	}
+};
+
+#endif
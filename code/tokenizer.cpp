@@ -0,0 +1,131 @@
+#include <climits>
+
+#include "tokenizer.h"
+
+/**
+	Constructor creating tokenizer of the text.
+	@param begin Beginning of the text.
+	@param end End of the text.
+	@param first_line Number of the first line of the text, used when the text is a part of a longer one.
+*/
+Tokenizer::Tokenizer( const char * begin, const char * end, int first_line ){
+	this->position = begin;
+	this->end = end;
+	this->line_no = first_line - 1;
+	this->started = false;
+}
+
+/**
+	Method skips the rest of the current line and enters the next one.
+	@return Method returns false if there are no more lines.
+*/
+bool Tokenizer::next_line(){
+	if( this->started ){
+		while( this->position != this->end && *this->position != '\n' ){
+			this->position++;
+		}
+		if( this->position == this->end ){
+			return false;
+		}
+		this->position++;
+	}
+	this->started = true;
+	if( this->position == this->end ){
+		return false;
+	}
+	this->line_no++;
+	return true;
+}
+
+/**
+	Method reads next token of the current line.
+	@param [out] token View of the token.
+	@return Method returns false if there are no more tokens in the current line.
+*/
+bool Tokenizer::token( std::string_view & token ){
+	while( this->position != this->end && ( *this->position == ' ' || *this->position == '\t' || *this->position == '\r' ) ){
+		this->position++;
+	}
+	if( this->position == this->end || *this->position == '\n' ){
+		return false;
+	}
+	const char * begin = this->position;
+	while( this->position != this->end && *this->position != ' ' && *this->position != '\t' && *this->position != '\r' && *this->position != '\n' ){
+		this->position++;
+	}
+	token = std::string_view( begin, this->position - begin );
+	return true;
+}
+
+/**
+	@return Method returns number of the current line, counting from 1.
+*/
+int Tokenizer::line() const{
+	return this->line_no;
+}
+
+/**
+	Function converts token to a number.
+	@param token Token consisting of optional sign and decimal digits.
+	@param [out] value Value of the number.
+	@return Function returns false if the token is not a number.
+*/
+bool Tokenizer::number( std::string_view token, int & value ){
+	size_t i = 0;
+	bool negative = false;
+	if( i < token.size() && ( token[i] == '-' || token[i] == '+' ) ){
+		negative = token[i] == '-';
+		i++;
+	}
+	if( i == token.size() ){
+		return false;
+	}
+	long long result = 0;
+	for( ; i < token.size(); i++ ){
+		if( token[i] < '0' || token[i] > '9' ){
+			return false;
+		}
+		result = result * 10 + ( token[i] - '0' );
+		if( result > INT_MAX ){
+			return false;
+		}
+	}
+	value = negative ? -result : result;
+	return true;
+}
+
+/**
+	Function converts token to an unsigned 64-bit number.
+	@param token Token consisting of decimal digits, or of 0x followed by hexadecimal digits.
+	@param [out] value Value of the number.
+	@return Function returns false if the token is not a number or it doesn't fit 64 bits.
+*/
+bool Tokenizer::number( std::string_view token, uint64_t & value ){
+	int base = 10;
+	if( token.size() > 2 && token[0] == '0' && ( token[1] == 'x' || token[1] == 'X' ) ){
+		base = 16;
+		token.remove_prefix( 2 );
+	}
+	if( token.empty() ){
+		return false;
+	}
+	uint64_t result = 0;
+	for( char c : token ){
+		int digit;
+		if( c >= '0' && c <= '9' ){
+			digit = c - '0';
+		}else if( base == 16 && c >= 'a' && c <= 'f' ){
+			digit = c - 'a' + 10;
+		}else if( base == 16 && c >= 'A' && c <= 'F' ){
+			digit = c - 'A' + 10;
+		}else{
+			return false;
+		}
+		if( result > ( UINT64_MAX - digit ) / base ){
+			return false;
+		}
+		result = result * base + digit;
+	}
+	value = result;
+	return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file tokenizer.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class splitting text into lines and tokens.
+ */
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstdint>
+#include <string_view>
+
+/**
+Class splitting text held in memory into lines and whitespace separated tokens.
+Tokens are views into the text, so parsing does not allocate any memory.
+ */
+class Tokenizer
+{
+	const char * position;	//**<Current position in the text
+	const char * end;		//**<End of the text
+	int line_no;			//**<Number of the current line, 0 before the first line
+	bool started;			//**<Flag set when the first line has been entered
+
+public:
+	/**
+		Constructor creating tokenizer of the text.
+		@param begin Beginning of the text.
+		@param end End of the text.
+		@param first_line Number of the first line of the text, used when the text is a part of a longer one.
+	*/
+	Tokenizer( const char * begin, const char * end, int first_line = 1 );
+
+	/**
+		Method skips the rest of the current line and enters the next one.
+		@return Method returns false if there are no more lines.
+	*/
+	bool next_line();
+
+	/**
+		Method reads next token of the current line.
+		@param [out] token View of the token.
+		@return Method returns false if there are no more tokens in the current line.
+	*/
+	bool token( std::string_view & token );
+
+	/**
+		@return Method returns number of the current line, counting from 1.
+	*/
+	int line() const;
+
+	/**
+		Function converts token to a number.
+		@param token Token consisting of optional sign and decimal digits.
+		@param [out] value Value of the number.
+		@return Function returns false if the token is not a number.
+	*/
+	static bool number( std::string_view token, int & value );
+
+	/**
+		Function converts token to an unsigned 64-bit number.
+		@param token Token consisting of decimal digits, or of 0x followed by hexadecimal digits.
+		@param [out] value Value of the number.
+		@return Function returns false if the token is not a number or it doesn't fit 64 bits.
+	*/
+	static bool number( std::string_view token, uint64_t & value );
+};
+
+#endif
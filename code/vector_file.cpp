@@ -0,0 +1,143 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "vector_file.h"
+
+static const char magic[] = { 'D', 'L', 'S', 'V' };
+static const size_t count_offset = 16;
+static const size_t nodes_offset = 24;
+
+/**
+	Constructor with no parameters.
+*/
+VectorFile::VectorFile(){
+	this->count = 0;
+	this->words = NULL;
+}
+
+/**
+	@param fname Name of the file.
+	@return Function returns true if the file starts with the magic of the binary format, pipes and devices are always read as text.
+*/
+bool VectorFile::is_binary( const std::string & fname ){
+	//Reading the magic from a pipe would consume it before the text is parsed
+	std::error_code error;
+	if( !std::filesystem::is_regular_file( fname, error ) ){
+		return false;
+	}
+	std::ifstream file( fname, std::ios::binary );
+	char header[ sizeof( magic ) ];
+	return file.read( header, sizeof( header ) ) && memcmp( header, magic, sizeof( magic ) ) == 0;
+}
+
+/**
+	Method maps the file into memory and checks its header.
+	@param fname Name of the file.
+	@return Method returns empty string on success, otherwise returns an error message.
+*/
+std::string VectorFile::open( const std::string & fname ){
+	if( !this->file.open( fname ) ){
+		return "error: Couldn't open inputs file for reading!";
+	}
+	const unsigned char * data = ( const unsigned char * )this->file.data();
+	if( this->file.size() < nodes_offset ){
+		return fname + ": error: truncated header of binary file";
+	}
+
+	uint32_t version;
+	uint32_t node_count;
+	uint64_t count;
+	memcpy( &version, data + 4, sizeof( version ) );
+	memcpy( &node_count, data + 8, sizeof( node_count ) );
+	memcpy( &count, data + count_offset, sizeof( count ) );
+	if( memcmp( data, magic, sizeof( magic ) ) != 0 ){
+		return fname + ": error: not a binary file with sets of values";
+	}
+	if( version != VectorFile::version ){
+		return fname + ": error: unsupported version of binary file: " + std::to_string( version );
+	}
+	//Sizes are compared by division, so huge counts from a corrupt header can't overflow
+	size_t words_offset = nodes_offset + ( node_count * sizeof( uint32_t ) + 7 ) / 8 * 8;
+	if( words_offset > this->file.size() || ( node_count != 0 && count > ( this->file.size() - words_offset ) / ( node_count * sizeof( uint64_t ) ) * 64 ) ){
+		return fname + ": error: binary file is shorter than declared in its header";
+	}
+	//Without nodes the file holds no words which would bound the number of sets
+	if( node_count == 0 && count != 0 ){
+		return fname + ": error: binary file declares sets without nodes";
+	}
+	this->_nodes.resize( node_count );
+	for( uint32_t i = 0; i < node_count; i++ ){
+		uint32_t node;
+		memcpy( &node, data + nodes_offset + i * sizeof( node ), sizeof( node ) );
+		this->_nodes[i] = node;
+	}
+	this->count = count;
+	this->words = ( const uint64_t * )( data + words_offset );
+	return "";
+}
+
+/**
+	@return Method returns numbers of nodes in the order of their bits.
+*/
+const std::vector< int > & VectorFile::nodes() const{
+	return this->_nodes;
+}
+
+/**
+	@return Method returns number of sets stored in the file.
+*/
+size_t VectorFile::size() const{
+	return this->count;
+}
+
+/**
+	@return Method returns number of blocks of 64 sets stored in the file.
+*/
+size_t VectorFile::blocks() const{
+	return ( this->count + 63 ) / 64;
+}
+
+/**
+	@param block Index of the block.
+	@return Method returns pointer to the words of every node in the block.
+*/
+const uint64_t * VectorFile::block( size_t block ) const{
+	return this->words + block * this->_nodes.size();
+}
+
+/**
+	Function writes header of the binary format.
+	@param file Stream the header is written to, it has to be opened in binary mode.
+	@param nodes Numbers of nodes in the order of their bits.
+	@param count Number of sets which will follow the header.
+*/
+void VectorFile::write_header( std::ostream & file, const std::vector< int > & nodes, uint64_t count ){
+	uint32_t version = VectorFile::version;
+	uint32_t node_count = nodes.size();
+	uint32_t reserved = 0;
+	file.write( magic, sizeof( magic ) );
+	file.write( ( const char * )&version, sizeof( version ) );
+	file.write( ( const char * )&node_count, sizeof( node_count ) );
+	file.write( ( const char * )&reserved, sizeof( reserved ) );
+	file.write( ( const char * )&count, sizeof( count ) );
+	for( int node : nodes ){
+		uint32_t number = node;
+		file.write( ( const char * )&number, sizeof( number ) );
+	}
+	if( nodes.size() % 2 ){
+		file.write( ( const char * )&reserved, sizeof( reserved ) );
+	}
+}
+
+/**
+	Function updates number of sets in the header written at the beginning of the stream.
+	@param file Stream the header has been written to.
+	@param count Number of sets written to the file.
+*/
+void VectorFile::update_count( std::ostream & file, uint64_t count ){
+	auto position = file.tellp();
+	file.seekp( count_offset );
+	file.write( ( const char * )&count, sizeof( count ) );
+	file.seekp( position );
+}
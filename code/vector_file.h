@@ -0,0 +1,98 @@
+/**
+ * @file vector_file.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class reading binary files with packed sets of logic values.
+ */
+
+#ifndef VECTOR_FILE_H
+#define VECTOR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+/**
+Class giving access to binary file with packed sets of logic values, the file is mapped into memory instead of being read.
+
+Layout of the file, all numbers are little endian:
+	- magic "DLSV" and 32-bit version number,
+	- 32-bit number of nodes, 32 reserved bits and 64-bit number of sets,
+	- 32-bit numbers of the nodes in the order of their bits, padded with zeros to a multiple of 8 bytes,
+	- blocks of 64 sets, each block holds one 64-bit word per node, bit b of the word is the value of the node in set 64 * block + b.
+
+Blocks have the same layout as blocks of VectorSet, so they are copied without any repacking.
+ */
+class VectorFile
+{
+	MappedFile file;					//**<File mapped into memory
+	std::vector< int > _nodes;			//**<Numbers of nodes in the order of their bits
+	size_t count;						//**<Number of sets stored in the file
+	const uint64_t * words;				//**<Beginning of the first block
+
+public:
+	static const uint32_t version = 1;	//**<Version of the format written by this program
+
+	/**
+		Constructor with no parameters.
+	*/
+	VectorFile();
+
+	VectorFile( const VectorFile & ) = delete;
+	VectorFile & operator=( const VectorFile & ) = delete;
+
+	/**
+		@param fname Name of the file.
+		@return Function returns true if the file starts with the magic of the binary format, pipes and devices are always read as text.
+	*/
+	static bool is_binary( const std::string & fname );
+
+	/**
+		Method maps the file into memory and checks its header.
+		@param fname Name of the file.
+		@return Method returns empty string on success, otherwise returns an error message.
+	*/
+	std::string open( const std::string & fname );
+
+	/**
+		@return Method returns numbers of nodes in the order of their bits.
+	*/
+	const std::vector< int > & nodes() const;
+
+	/**
+		@return Method returns number of sets stored in the file.
+	*/
+	size_t size() const;
+
+	/**
+		@return Method returns number of blocks of 64 sets stored in the file.
+	*/
+	size_t blocks() const;
+
+	/**
+		@param block Index of the block.
+		@return Method returns pointer to the words of every node in the block.
+	*/
+	const uint64_t * block( size_t block ) const;
+
+	/**
+		Function writes header of the binary format.
+		@param file Stream the header is written to, it has to be opened in binary mode.
+		@param nodes Numbers of nodes in the order of their bits.
+		@param count Number of sets which will follow the header.
+	*/
+	static void write_header( std::ostream & file, const std::vector< int > & nodes, uint64_t count );
+
+	/**
+		Function updates number of sets in the header written at the beginning of the stream.
+		@param file Stream the header has been written to.
+		@param count Number of sets written to the file.
+	*/
+	static void update_count( std::ostream & file, uint64_t count );
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "vector_set.h"
+
+/**
+	Constructor creating empty set.
+	@param width Number of nodes in every vector.
+*/
+VectorSet::VectorSet( int width ){
+	this->reset( width );
+}
+
+/**
+	Method removes all vectors and changes number of nodes in every vector.
+	@param width Number of nodes in every vector.
+*/
+void VectorSet::reset( int width ){
+	this->_width = width;
+	this->count = 0;
+	this->values.clear();
+	this->defined.clear();
+}
+
+/**
+	Method appends vector with all values undefined.
+	@return Method returns index of appended vector.
+*/
+size_t VectorSet::push_back(){
+	this->resize( this->count + 1 );
+	return this->count - 1;
+}
+
+/**
+	Method changes number of stored vectors, new vectors have all values undefined.
+	@param count New number of vectors.
+*/
+void VectorSet::resize( size_t count ){
+	size_t blocks = ( count + 63 ) / 64;
+	//Clearing bits of removed vectors, so they don't show up when the set grows again
+	for( size_t vector = count; vector < this->count && vector % 64; vector++ ){
+		uint64_t mask = ~( uint64_t( 1 ) << ( vector % 64 ) );
+		for( int node = 0; node < this->_width; node++ ){
+			this->values[ vector / 64 * this->_width + node ] &= mask;
+			this->defined[ vector / 64 * this->_width + node ] &= mask;
+		}
+	}
+	this->values.resize( blocks * this->_width );
+	this->defined.resize( blocks * this->_width );
+	this->count = count;
+}
+
+/**
+	Method sets value of the node in the vector and marks it as defined.
+	@param vector Index of the vector.
+	@param node Index of the node.
+	@param value Value to be set.
+*/
+void VectorSet::set( size_t vector, int node, bool value ){
+	size_t index = vector / 64 * this->_width + node;
+	uint64_t bit = uint64_t( 1 ) << ( vector % 64 );
+	if( value ){
+		this->values[ index ] |= bit;
+	}else{
+		this->values[ index ] &= ~bit;
+	}
+	this->defined[ index ] |= bit;
+}
+
+/**
+	Method sets value of the node in the vector together with its flag of definition, undefined values are unknown.
+	@param vector Index of the vector.
+	@param node Index of the node.
+	@param value Value to be set.
+	@param defined True if the value is defined.
+*/
+void VectorSet::set( size_t vector, int node, bool value, bool defined ){
+	this->set( vector, node, value );
+	if( !defined ){
+		this->defined[ vector / 64 * this->_width + node ] &= ~( uint64_t( 1 ) << ( vector % 64 ) );
+	}
+}
+
+/**
+	@param vector Index of the vector.
+	@param node Index of the node.
+	@return Method returns value of the node in the vector.
+*/
+bool VectorSet::value( size_t vector, int node ) const{
+	return ( this->values[ vector / 64 * this->_width + node ] >> ( vector % 64 ) ) & 1;
+}
+
+/**
+	@param vector Index of the vector.
+	@param node Index of the node.
+	@return Method returns true if the value of the node in the vector has been defined.
+*/
+bool VectorSet::is_defined( size_t vector, int node ) const{
+	return ( this->defined[ vector / 64 * this->_width + node ] >> ( vector % 64 ) ) & 1;
+}
+
+/**
+	Method reads values of the node in 64 consecutive vectors, bit i belongs to vector first + i, missing vectors are undefined 0.
+	@param first Index of the first vector, it doesn't have to be aligned to a block.
+	@param node Index of the node.
+	@param [out] values Packed values.
+	@param [out] defined Packed flags of defined values.
+*/
+void VectorSet::word( size_t first, int node, uint64_t & values, uint64_t & defined ) const{
+	values = 0;
+	defined = 0;
+	if( first >= this->count ){
+		return;
+	}
+	//Unaligned word is put together from the ends of two neighbouring blocks
+	size_t index = first / 64 * this->_width + node;
+	int shift = first % 64;
+	values = this->values[ index ] >> shift;
+	defined = this->defined[ index ] >> shift;
+	if( shift && index + this->_width < this->values.size() ){
+		values |= this->values[ index + this->_width ] << ( 64 - shift );
+		defined |= this->defined[ index + this->_width ] << ( 64 - shift );
+	}
+}
+
+/**
+	Method sets values of the node in consecutive vectors together with their flags of definition.
+	@param first Index of the first vector, it doesn't have to be aligned to a block.
+	@param node Index of the node.
+	@param values Values to be set, bit i belongs to vector first + i.
+	@param defined Flags of defined values to be set.
+	@param count Number of vectors to be set, at most 64.
+*/
+void VectorSet::set_word( size_t first, int node, uint64_t values, uint64_t defined, int count ){
+	uint64_t mask = count >= 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << count ) - 1;
+	size_t index = first / 64 * this->_width + node;
+	int shift = first % 64;
+	this->values[ index ] = ( this->values[ index ] & ~( mask << shift ) ) | ( values & mask ) << shift;
+	this->defined[ index ] = ( this->defined[ index ] & ~( mask << shift ) ) | ( defined & mask ) << shift;
+	if( shift && mask >> ( 64 - shift ) ){
+		index += this->_width;
+		this->values[ index ] = ( this->values[ index ] & ~( mask >> ( 64 - shift ) ) ) | ( values & mask ) >> ( 64 - shift );
+		this->defined[ index ] = ( this->defined[ index ] & ~( mask >> ( 64 - shift ) ) ) | ( defined & mask ) >> ( 64 - shift );
+	}
+}
+
+/**
+	@param block Index of the block of 64 vectors.
+	@return Method returns pointer to packed values of every node in the block.
+*/
+uint64_t * VectorSet::block_values( size_t block ){
+	return this->values.data() + block * this->_width;
+}
+
+/**
+	@param block Index of the block of 64 vectors.
+	@return Method returns pointer to packed values of every node in the block.
+*/
+const uint64_t * VectorSet::block_values( size_t block ) const{
+	return this->values.data() + block * this->_width;
+}
+
+/**
+	@param block Index of the block of 64 vectors.
+	@return Method returns pointer to packed flags of defined values of every node in the block.
+*/
+uint64_t * VectorSet::block_defined( size_t block ){
+	return this->defined.data() + block * this->_width;
+}
+
+/**
+	@param block Index of the block of 64 vectors.
+	@return Method returns pointer to packed flags of defined values of every node in the block.
+*/
+const uint64_t * VectorSet::block_defined( size_t block ) const{
+	return this->defined.data() + block * this->_width;
+}
+
+/**
+	@return Method returns number of stored vectors.
+*/
+size_t VectorSet::size() const{
+	return this->count;
+}
+
+/**
+	@return Method returns number of blocks of 64 vectors.
+*/
+size_t VectorSet::blocks() const{
+	return ( this->count + 63 ) / 64;
+}
+
+/**
+	@return Method returns number of nodes in every vector.
+*/
+int VectorSet::width() const{
+	return this->_width;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file vector_set.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of class storing packed sets of logic values.
+ */
+
+#ifndef VECTOR_SET_H
+#define VECTOR_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+Class storing sets of logic values (vectors) of a fixed group of nodes.
+Values are packed bit-parallel in blocks of 64 vectors: bit b of word [ block * width + node ] holds the value of the node in vector 64 * block + b,
+so a whole block can be loaded straight into the bit-parallel evaluation without repacking.
+Every value has a companion bit telling whether it has been defined, in four-valued simulation undefined value 0 stands for X and undefined value 1 for Z.
+ */
+class VectorSet
+{
+	int _width;							//**<Number of nodes in every vector
+	size_t count;						//**<Number of stored vectors
+	std::vector< uint64_t > values;		//**<Packed values of the nodes
+	std::vector< uint64_t > defined;	//**<Packed flags set for values which have been defined
+
+public:
+	/**
+		Constructor creating empty set.
+		@param width Number of nodes in every vector.
+	*/
+	VectorSet( int width = 0 );
+
+	/**
+		Method removes all vectors and changes number of nodes in every vector.
+		@param width Number of nodes in every vector.
+	*/
+	void reset( int width );
+
+	/**
+		Method appends vector with all values undefined.
+		@return Method returns index of appended vector.
+	*/
+	size_t push_back();
+
+	/**
+		Method changes number of stored vectors, new vectors have all values undefined.
+		@param count New number of vectors.
+	*/
+	void resize( size_t count );
+
+	/**
+		Method sets value of the node in the vector and marks it as defined.
+		@param vector Index of the vector.
+		@param node Index of the node.
+		@param value Value to be set.
+	*/
+	void set( size_t vector, int node, bool value );
+
+	/**
+		Method sets value of the node in the vector together with its flag of definition, undefined values are unknown.
+		@param vector Index of the vector.
+		@param node Index of the node.
+		@param value Value to be set.
+		@param defined True if the value is defined.
+	*/
+	void set( size_t vector, int node, bool value, bool defined );
+
+	/**
+		@param vector Index of the vector.
+		@param node Index of the node.
+		@return Method returns value of the node in the vector.
+	*/
+	bool value( size_t vector, int node ) const;
+
+	/**
+		@param vector Index of the vector.
+		@param node Index of the node.
+		@return Method returns true if the value of the node in the vector has been defined.
+	*/
+	bool is_defined( size_t vector, int node ) const;
+
+	/**
+		Method reads values of the node in 64 consecutive vectors, bit i belongs to vector first + i, missing vectors are undefined 0.
+		@param first Index of the first vector, it doesn't have to be aligned to a block.
+		@param node Index of the node.
+		@param [out] values Packed values.
+		@param [out] defined Packed flags of defined values.
+	*/
+	void word( size_t first, int node, uint64_t & values, uint64_t & defined ) const;
+
+	/**
+		Method sets values of the node in consecutive vectors together with their flags of definition.
+		@param first Index of the first vector, it doesn't have to be aligned to a block.
+		@param node Index of the node.
+		@param values Values to be set, bit i belongs to vector first + i.
+		@param defined Flags of defined values to be set.
+		@param count Number of vectors to be set, at most 64.
+	*/
+	void set_word( size_t first, int node, uint64_t values, uint64_t defined, int count );
+
+	/**
+		@param block Index of the block of 64 vectors.
+		@return Method returns pointer to packed values of every node in the block.
+	*/
+	uint64_t * block_values( size_t block );
+
+	/**
+		@param block Index of the block of 64 vectors.
+		@return Method returns pointer to packed values of every node in the block.
+	*/
+	const uint64_t * block_values( size_t block ) const;
+
+	/**
+		@param block Index of the block of 64 vectors.
+		@return Method returns pointer to packed flags of defined values of every node in the block.
+	*/
+	uint64_t * block_defined( size_t block );
+
+	/**
+		@param block Index of the block of 64 vectors.
+		@return Method returns pointer to packed flags of defined values of every node in the block.
+	*/
+	const uint64_t * block_defined( size_t block ) const;
+
+	/**
+		@return Method returns number of stored vectors.
+	*/
+	size_t size() const;
+
+	/**
+		@return Method returns number of blocks of 64 vectors.
+	*/
+	size_t blocks() const;
+
+	/**
+		@return Method returns number of nodes in every vector.
+	*/
+	int width() const;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include <map>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "waveform.h"
+
+/** Number of chunks waiting for the writing thread before evaluation is stalled */
+static const size_t waiting_chunks = 4;
+
+/** Size of the formatted text written to the file at once */
+static const size_t buffer_size = 1 << 20;
+
+/**
+	Constructor creating closed writer.
+*/
+WaveformWriter::WaveformWriter() : file( NULL ), compressor( -1 ), started( false ), failed( false ), chunks( waiting_chunks ){
+}
+
+/**
+	Destructor closing the writer.
+*/
+WaveformWriter::~WaveformWriter(){
+	this->close();
+}
+
+/** Method opens the file, writes its header and starts the writing thread.
+	@param fname Name of the file, name ending with .gz selects compressed file.
+	@param nodes Numbers of the traced nodes from the circuit file.
+	@param levels Level of every traced node, variables are grouped into scopes by levels.
+	@return Method returns empty string on success, otherwise returns an error message.
+*/
+std::string WaveformWriter::open( const std::string & fname, const std::vector< int > & nodes, const std::vector< uint32_t > & levels ){
+	const std::string extension = ".gz";
+	bool compressed = fname.size() > extension.size() && fname.compare( fname.size() - extension.size(), extension.size(), extension ) == 0;
+	if( compressed ){
+		//Compressor is executed without shell, it writes the file opened here, so the name is never interpreted
+		int output = ::open( fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666 );
+		if( output < 0 ){
+			return "error: Couldn't open waveform file for writing!";
+		}
+		int ends[2];
+		if( pipe2( ends, O_CLOEXEC ) != 0 ){
+			::close( output );
+			return "error: Couldn't open waveform file for writing!";
+		}
+		this->compressor = fork();
+		if( this->compressor == 0 ){
+			if( dup2( ends[0], STDIN_FILENO ) < 0 || dup2( output, STDOUT_FILENO ) < 0 ){
+				_exit( 127 );
+			}
+			execlp( "gzip", "gzip", "-c", ( char * )NULL );
+			_exit( 127 );
+		}
+		::close( output );
+		::close( ends[0] );
+		this->file = this->compressor < 0 ? NULL : fdopen( ends[1], "w" );
+		if( this->file == NULL ){
+			::close( ends[1] );
+			if( this->compressor > 0 ){
+				waitpid( this->compressor, NULL, 0 );
+			}
+			this->compressor = -1;
+		}
+	}else{
+		this->file = fopen( fname.c_str(), "w" );
+	}
+	if( this->file == NULL ){
+		return "error: Couldn't open waveform file for writing!";
+	}
+
+	//Identifier codes are numbers written with printable characters from '!' to '~'
+	this->codes.resize( nodes.size() );
+	for( size_t k = 0; k < nodes.size(); k++ ){
+		size_t number = k;
+		do{
+			this->codes[k].push_back( char( '!' + number % 94 ) );
+			number /= 94;
+		}while( number );
+	}
+	this->last.assign( nodes.size(), 0 );
+	this->started = false;
+	this->failed = false;
+
+	std::map< uint32_t, std::vector< size_t > > scopes;
+	for( size_t k = 0; k < nodes.size(); k++ ){
+		scopes[ levels[k] ].push_back( k );
+	}
+	this->buffer = "$version dct $end\n$timescale 1ns $end\n$scope module circuit $end\n";
+	for( const auto & scope : scopes ){
+		this->buffer += "$scope module level_" + std::to_string( scope.first ) + " $end\n";
+		for( size_t k : scope.second ){
+			this->buffer += "$var wire 1 " + this->codes[k] + " n" + std::to_string( nodes[k] ) + " $end\n";
+		}
+		this->buffer += "$upscope $end\n";
+	}
+	this->buffer += "$upscope $end\n$enddefinitions $end\n";
+
+	this->thread = std::thread( [ this ](){
+		//Writing to the pipe of a compressor which has exited fails instead of killing the process, all writes are done by this thread
+		sigset_t signals;
+		sigemptyset( &signals );
+		sigaddset( &signals, SIGPIPE );
+		pthread_sigmask( SIG_BLOCK, &signals, NULL );
+		WaveformChunk chunk;
+		while( this->chunks.pop( chunk ) ){
+			this->format( chunk );
+			if( this->buffer.size() >= buffer_size ){
+				this->flush();
+			}
+		}
+		this->flush();
+		if( fflush( this->file ) != 0 ){
+			this->failed = true;
+		}
+	} );
+	return "";
+}
+
+/** Method passes chunk to the writing thread, waiting while too many chunks are waiting.
+	Chunks have to be written in the order of their sets.
+	@param chunk Written chunk.
+*/
+void WaveformWriter::write( WaveformChunk chunk ){
+	this->chunks.push( std::move( chunk ) );
+}
+
+/** Method formats changes of the values from the chunk into the buffer.
+	@param chunk Written chunk.
+*/
+void WaveformWriter::format( const WaveformChunk & chunk ){
+	size_t blocks = ( chunk.count + 63 ) / 64;
+	size_t traced = this->codes.size();
+	if( chunk.count == 0 ){
+		return;
+	}
+	if( !this->started ){
+		this->buffer += "#" + std::to_string( chunk.first ) + "\n$dumpvars\n";
+		for( size_t k = 0; k < traced; k++ ){
+			this->last[k] = chunk.words[ k * blocks ] & 1;
+			this->buffer += char( '0' + this->last[k] ) + this->codes[k] + "\n";
+		}
+		this->buffer += "$end\n";
+		this->started = true;
+	}
+
+	//Changes of every node are found for 64 sets at once, set is compared with the previous one shifted in from the lower word
+	std::vector< uint64_t > changes( traced * blocks );
+	std::vector< uint64_t > changed( blocks, 0 );
+	for( size_t k = 0; k < traced; k++ ){
+		uint64_t previous = this->last[k];
+		for( size_t b = 0; b < blocks; b++ ){
+			uint64_t word = chunk.words[ k * blocks + b ];
+			uint64_t valid = ( b + 1 ) * 64 <= chunk.count ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( chunk.count % 64 ) ) - 1;
+			changes[ k * blocks + b ] = ( word ^ ( ( word << 1 ) | previous ) ) & valid;
+			changed[b] |= changes[ k * blocks + b ];
+			previous = word >> 63;
+		}
+		this->last[k] = ( chunk.words[ k * blocks + ( chunk.count - 1 ) / 64 ] >> ( ( chunk.count - 1 ) % 64 ) ) & 1;
+	}
+	for( size_t b = 0; b < blocks; b++ ){
+		for( uint64_t sets = changed[b]; sets; sets &= sets - 1 ){
+			int bit = __builtin_ctzll( sets );
+			this->buffer += "#" + std::to_string( chunk.first + b * 64 + bit ) + "\n";
+			for( size_t k = 0; k < traced; k++ ){
+				if( ( changes[ k * blocks + b ] >> bit ) & 1 ){
+					this->buffer += char( '0' + ( ( chunk.words[ k * blocks + b ] >> bit ) & 1 ) ) + this->codes[k] + "\n";
+				}
+			}
+		}
+	}
+}
+
+/** Method writes the buffer to the file.
+*/
+void WaveformWriter::flush(){
+	if( !this->buffer.empty() && fwrite( this->buffer.data(), 1, this->buffer.size(), this->file ) != this->buffer.size() ){
+		this->failed = true;
+	}
+	this->buffer.clear();
+}
+
+/** Method waits until all chunks are written and closes the file.
+	@return Method returns empty string on success, otherwise returns an error message.
+*/
+std::string WaveformWriter::close(){
+	if( this->file == NULL ){
+		return "";
+	}
+	this->chunks.close();
+	this->thread.join();
+	int status = fclose( this->file );
+	this->file = NULL;
+	if( this->compressor > 0 ){
+		int exit_status;
+		if( waitpid( this->compressor, &exit_status, 0 ) != this->compressor || !WIFEXITED( exit_status ) || WEXITSTATUS( exit_status ) != 0 ){
+			status = -1;
+		}
+		this->compressor = -1;
+	}
+	if( this->failed || status != 0 ){
+		return "error: Couldn't write waveform file!";
+	}
+	return "";
+}
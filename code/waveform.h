@@ -0,0 +1,90 @@
+/**
+ * @file waveform.h
+ * @author Michał Ferenc
+ * @date 17.10.2026
+ * @brief File containing definition of writer of node values into Value Change Dump files.
+ */
+
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "channel.h"
+
+/**
+Structure holding packed values of the traced nodes for consecutive sets.
+*/
+struct WaveformChunk{
+	uint64_t first;/**< Index of the first set of the chunk among all written sets*/
+	size_t count;/**< Number of sets in the chunk*/
+	std::vector< uint64_t > words;/**< Values of traced node k for sets 64 * b to 64 * b + 63 of the chunk are stored in words[ k * blocks + b ], blocks is count / 64 rounded up*/
+};
+
+/**
+Class writing values of the traced nodes into Value Change Dump file, set i of the simulation is time i of the dump.
+Only changes of the values are written. Chunks are formatted and written by a separate thread, so evaluation continues while the file is written.
+Files with name ending with .gz are compressed by piping the dump through gzip executed without shell.
+ */
+class WaveformWriter
+{
+	FILE * file;							//**<Written file or pipe to the compressor, NULL if the writer is not opened
+	pid_t compressor;						//**<Process of gzip compressing the file, -1 if the file is not compressed
+	std::vector< std::string > codes;		//**<Identifier codes of the traced nodes in the dump
+	std::vector< uint64_t > last;			//**<Last written value of every traced node
+	bool started;							//**<Flag set once initial values have been written
+	std::string buffer;						//**<Formatted text waiting to be written to the file
+	bool failed;							//**<Flag set if writing to the file failed
+	Channel< WaveformChunk > chunks;		//**<Chunks waiting to be written
+	std::thread thread;						//**<Thread writing the chunks
+
+	/** Method formats changes of the values from the chunk into the buffer.
+		@param chunk Written chunk.
+	*/
+	void format( const WaveformChunk & chunk );
+
+	/** Method writes the buffer to the file.
+	*/
+	void flush();
+
+public:
+	/**
+		Constructor creating closed writer.
+	*/
+	WaveformWriter();
+
+	/**
+		Destructor closing the writer.
+	*/
+	~WaveformWriter();
+
+	WaveformWriter( const WaveformWriter & ) = delete;
+	WaveformWriter & operator=( const WaveformWriter & ) = delete;
+
+	/** Method opens the file, writes its header and starts the writing thread.
+		@param fname Name of the file, name ending with .gz selects compressed file.
+		@param nodes Numbers of the traced nodes from the circuit file.
+		@param levels Level of every traced node, variables are grouped into scopes by levels.
+		@return Method returns empty string on success, otherwise returns an error message.
+	*/
+	std::string open( const std::string & fname, const std::vector< int > & nodes, const std::vector< uint32_t > & levels );
+
+	/** Method passes chunk to the writing thread, waiting while too many chunks are waiting.
+		Chunks have to be written in the order of their sets.
+		@param chunk Written chunk.
+	*/
+	void write( WaveformChunk chunk );
+
+	/** Method waits until all chunks are written and closes the file.
+		@return Method returns empty string on success, otherwise returns an error message.
+	*/
+	std::string close();
+};
+
+#endif